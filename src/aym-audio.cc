@@ -146,7 +146,9 @@ AudioDevice::AudioDevice(const AudioConfig& config)
     {
         settings->pUserData       = this;
         settings->dataCallback    = callback;
-        settings->playback.format = ma_format_f32;
+        if(settings->playback.format == ma_format_unknown) {
+            settings->playback.format = ma_format_f32;
+        }
         return settings.get();
     };
 
@@ -45,6 +45,22 @@ using MutexLock       = std::unique_lock<std::mutex>;
 
 }
 
+// ---------------------------------------------------------------------------
+// aym::SampleFormat
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+enum SampleFormat
+{
+    FORMAT_INVALID = -1,
+    FORMAT_DEFAULT =  0,
+    FORMAT_S16     =  1,
+    FORMAT_F32     =  2,
+};
+
+}
+
 // ---------------------------------------------------------------------------
 // aym::MonoFrame<T>
 // ---------------------------------------------------------------------------
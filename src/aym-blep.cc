@@ -0,0 +1,313 @@
+/*
+ * aym-blep.cc - Copyright (c) 2023-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstdarg>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include "aym-blep.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::BlepTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct BlepTraits
+{
+    using BlepSynthesizer = aym::BlepSynthesizer;
+    using Output          = aym::Output;
+    using OutputInt32     = aym::OutputInt32;
+
+    template <typename T>
+    using BasicOutput = aym::BasicOutput<T>;
+
+#if defined(__AVX__)
+    static constexpr uint32_t width       = 8;
+#else
+    static constexpr uint32_t width       = 4;
+#endif
+    static constexpr double   cutoff      = 0.45;
+    static constexpr double   transition  = 0.15;
+    static constexpr double   attenuation = 80.0;
+
+    typedef float Vector __attribute__((vector_size(width * sizeof(float))));
+
+    static inline auto load(const float* input) -> Vector
+    {
+        Vector vector;
+        static_cast<void>(::memcpy(&vector, input, sizeof(vector)));
+        return vector;
+    }
+
+    static inline auto store(const Vector& vector, float* output) -> void
+    {
+        static_cast<void>(::memcpy(output, &vector, sizeof(vector)));
+    }
+
+    static inline auto store(const float value, float& output) -> void
+    {
+        output = value;
+    }
+
+    static inline auto store(const float value, int32_t& output) -> void
+    {
+        output = static_cast<int32_t>(std::lrint(value));
+    }
+
+    static inline auto bessel_i0(const double value) -> double
+    {
+        const double half = (value * 0.5);
+        double       term = 1.0;
+        double       sum  = 1.0;
+
+        for(int index = 1; index < 64; ++index) {
+            term *= (half / index) * (half / index);
+            sum  += term;
+            if(term < (sum * 1e-12)) {
+                break;
+            }
+        }
+        return sum;
+    }
+
+    static inline auto get_taps() -> uint32_t
+    {
+        const double   length = (attenuation - 8.0) / (2.285 * 2.0 * M_PI * transition);
+        const uint32_t taps   = static_cast<uint32_t>(std::ceil(length));
+
+        return ((taps + (width - 1)) / width) * width;
+    }
+
+    static inline auto interpolate(const float* row0, const float* row1, const float blend, float* kernel, const uint32_t taps) -> void
+    {
+        for(uint32_t index = 0; index < taps; index += width) {
+            const Vector lhs = load(row0 + index);
+            const Vector rhs = load(row1 + index);
+            store((lhs + ((rhs - lhs) * blend)), (kernel + index));
+        }
+    }
+
+    static inline auto accumulate(float* residual, const float* kernel, const float delta, const uint32_t taps) -> void
+    {
+        for(uint32_t index = 0; index < taps; index += width) {
+            store((load(residual + index) + (load(kernel + index) * delta)), (residual + index));
+        }
+    }
+
+    static inline auto build(std::vector<float>& table) -> uint32_t
+    {
+        const uint32_t taps   = get_taps();
+        const uint32_t points = (taps * BlepSynthesizer::PHASES);
+        const double   beta   = 0.1102 * (attenuation - 8.7);
+        const double   scale  = 1.0 / bessel_i0(beta);
+        const double   center = (static_cast<double>(taps) / 2.0);
+        std::vector<double> steps(points + 1);
+
+        auto get_impulse = [&](const uint32_t point) -> double
+        {
+            const double position = (static_cast<double>(point) / BlepSynthesizer::PHASES) - center;
+            const double ratio    = (position / center);
+            const double window   = bessel_i0(beta * std::sqrt(std::max((1.0 - (ratio * ratio)), 0.0))) * scale;
+            if(position == 0.0) {
+                return (2.0 * cutoff) * window;
+            }
+            return (std::sin(2.0 * M_PI * cutoff * position) / (M_PI * position)) * window;
+        };
+
+        auto integrate = [&]() -> void
+        {
+            double previous = get_impulse(0);
+            steps[0] = 0.0;
+            for(uint32_t point = 1; point <= points; ++point) {
+                const double current = get_impulse(point);
+                steps[point] = steps[point - 1] + (previous + current);
+                previous = current;
+            }
+        };
+
+        auto build = [&]() -> uint32_t
+        {
+            integrate();
+            table.resize((BlepSynthesizer::PHASES + 1) * taps);
+            for(uint32_t phase = 0; phase <= BlepSynthesizer::PHASES; ++phase) {
+                float* row = table.data() + (phase * taps);
+                for(uint32_t index = 0; index < taps; ++index) {
+                    row[index] = static_cast<float>(steps[((index + 1) * BlepSynthesizer::PHASES) - phase] / steps[points]);
+                }
+            }
+            return taps;
+        };
+
+        return build();
+    }
+
+    template <typename T, typename Switches>
+    static inline auto process(const uint32_t taps, const uint32_t clock, const uint32_t rate, uint32_t& primed, Output& current, Output& last, const std::vector<float>& table, std::vector<float>& kernel, std::vector<float> (&residual)[3], Switches& switches, const BasicOutput<T>* input, const uint32_t* offsets, const size_t edges, BasicOutput<T>* output, const size_t samples, const uint32_t remainder) -> void
+    {
+        const uint64_t divisor = std::max(clock, 1u);
+        size_t         next    = 0;
+
+        auto append = [&]() -> void
+        {
+            residual[0].resize(taps + samples + 1);
+            residual[1].resize(taps + samples + 1);
+            residual[2].resize(taps + samples + 1);
+        };
+
+        auto insert = [&](const BasicOutput<T>& value, const uint32_t offset) -> void
+        {
+            const Output level = {
+                static_cast<float>(value.channel0),
+                static_cast<float>(value.channel1),
+                static_cast<float>(value.channel2),
+            };
+            if(primed == 0) {
+                current = last = level;
+                primed  = 1;
+                return;
+            }
+            const uint64_t time     = (static_cast<uint64_t>(offset) * rate);
+            const uint64_t moment   = (time > remainder ? time - remainder : 0);
+            const uint64_t fraction = (moment % divisor) * BlepSynthesizer::PHASES;
+            const size_t   position = static_cast<size_t>(moment / divisor);
+            const float*   row      = table.data() + ((fraction / divisor) * taps);
+            const float    blend    = static_cast<float>(static_cast<double>(fraction % divisor) / static_cast<double>(divisor));
+            interpolate(row, (row + taps), blend, kernel.data(), taps);
+            if(level.channel0 != last.channel0) {
+                accumulate((residual[0].data() + position + 1), kernel.data(), (level.channel0 - last.channel0), taps);
+            }
+            if(level.channel1 != last.channel1) {
+                accumulate((residual[1].data() + position + 1), kernel.data(), (level.channel1 - last.channel1), taps);
+            }
+            if(level.channel2 != last.channel2) {
+                accumulate((residual[2].data() + position + 1), kernel.data(), (level.channel2 - last.channel2), taps);
+            }
+            switches.push_back({(position + taps + 1), level});
+            last = level;
+        };
+
+        auto synthesize = [&]() -> void
+        {
+            for(size_t index = 0; index < samples; ++index) {
+                while((next < switches.size()) && (switches[next].position <= index)) {
+                    current = switches[next].level;
+                    ++next;
+                }
+                store((current.channel0 + residual[0][index]), output[index].channel0);
+                store((current.channel1 + residual[1][index]), output[index].channel1);
+                store((current.channel2 + residual[2][index]), output[index].channel2);
+            }
+        };
+
+        auto shift = [&]() -> void
+        {
+            switches.erase(switches.begin(), (switches.begin() + next));
+            for(auto& entry : switches) {
+                entry.position -= samples;
+            }
+            residual[0].erase(residual[0].begin(), (residual[0].begin() + samples));
+            residual[1].erase(residual[1].begin(), (residual[1].begin() + samples));
+            residual[2].erase(residual[2].begin(), (residual[2].begin() + samples));
+        };
+
+        auto process = [&]() -> void
+        {
+            append();
+            for(size_t index = 0; index < edges; ++index) {
+                insert(input[index], offsets[index]);
+            }
+            synthesize();
+            shift();
+        };
+
+        return process();
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::BlepSynthesizer
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+BlepSynthesizer::BlepSynthesizer()
+    : _clock(0)
+    , _rate(0)
+    , _taps(0)
+    , _primed(0)
+    , _current()
+    , _last()
+    , _table()
+    , _kernel()
+    , _residual()
+    , _switches()
+{
+    configure(_clock, _rate);
+}
+
+auto BlepSynthesizer::reset() -> void
+{
+    _primed  = 0;
+    _current = Output();
+    _last    = Output();
+    _residual[0].assign((_taps + 1), 0.0f);
+    _residual[1].assign((_taps + 1), 0.0f);
+    _residual[2].assign((_taps + 1), 0.0f);
+    _switches.clear();
+}
+
+auto BlepSynthesizer::configure(uint32_t clock, uint32_t rate) -> void
+{
+    if((_taps != 0) && (_clock == clock) && (_rate == rate)) {
+        return;
+    }
+    _clock = clock;
+    _rate  = rate;
+    _taps  = BlepTraits::build(_table);
+    _kernel.resize(_taps);
+    reset();
+}
+
+auto BlepSynthesizer::process(const Output* input, const uint32_t* offsets, size_t edges, Output* output, size_t samples, uint32_t remainder) -> void
+{
+    return BlepTraits::process(_taps, _clock, _rate, _primed, _current, _last, _table, _kernel, _residual, _switches, input, offsets, edges, output, samples, remainder);
+}
+
+auto BlepSynthesizer::process(const OutputInt32* input, const uint32_t* offsets, size_t edges, OutputInt32* output, size_t samples, uint32_t remainder) -> void
+{
+    return BlepTraits::process(_taps, _clock, _rate, _primed, _current, _last, _table, _kernel, _residual, _switches, input, offsets, edges, output, samples, remainder);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,84 @@
+/*
+ * aym-blep.h - Copyright (c) 2023-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __AYM_Blep_h__
+#define __AYM_Blep_h__
+
+#include "aym-emulator.h"
+
+// ---------------------------------------------------------------------------
+// aym::BlepSynthesizer
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+class BlepSynthesizer
+{
+public: // public interface
+    static constexpr uint32_t PHASES = 64;
+
+    BlepSynthesizer();
+
+    BlepSynthesizer(BlepSynthesizer&&) = delete;
+
+    BlepSynthesizer(const BlepSynthesizer&) = delete;
+
+    BlepSynthesizer& operator=(BlepSynthesizer&&) = delete;
+
+    BlepSynthesizer& operator=(const BlepSynthesizer&) = delete;
+
+    virtual ~BlepSynthesizer() = default;
+
+    auto reset() -> void;
+
+    auto configure(uint32_t clock, uint32_t rate) -> void;
+
+    auto process(const Output* input, const uint32_t* offsets, size_t edges, Output* output, size_t samples, uint32_t remainder) -> void;
+
+    auto process(const OutputInt32* input, const uint32_t* offsets, size_t edges, OutputInt32* output, size_t samples, uint32_t remainder) -> void;
+
+    auto get_taps() const -> uint32_t
+    {
+        return _taps;
+    }
+
+protected: // protected types
+    struct Switch
+    {
+        size_t position;
+        Output level;
+    };
+
+protected: // protected data
+    uint32_t            _clock;
+    uint32_t            _rate;
+    uint32_t            _taps;
+    uint32_t            _primed;
+    Output              _current;
+    Output              _last;
+    std::vector<float>  _table;
+    std::vector<float>  _kernel;
+    std::vector<float>  _residual[3];
+    std::vector<Switch> _switches;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __AYM_Blep_h__ */
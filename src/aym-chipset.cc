@@ -0,0 +1,258 @@
+/*
+ * aym-chipset.cc - Copyright (c) 2023-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstdarg>
+#include <memory>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include "aym-chipset.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::ChipSetTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct ChipSetTraits
+{
+    using Emulator    = aym::Emulator;
+    using Output      = aym::Output;
+    using OutputInt32 = aym::OutputInt32;
+
+    static inline auto get_output(const Emulator& chip, Output& output) -> void
+    {
+        output = chip.get_output();
+    }
+
+    static inline auto get_output(const Emulator& chip, OutputInt32& output) -> void
+    {
+        chip.get_output(output);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::ChipSet
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+ChipSet::ChipSet(const ChipType type, const size_t count, Interface& interface, const Kernels& kernels)
+    : _chips()
+    , _active(count)
+    , _panning(Panning::PANNING_DEFAULT)
+    , _remainder(0)
+    , _mixer(kernels)
+{
+    if((count == 0) || (count > MAX_CHIPS)) {
+        throw std::runtime_error("invalid number of chips");
+    }
+    for(size_t index = 0; index < count; ++index) {
+        _chips.emplace_back(new Emulator(type, interface));
+    }
+    configure(Panning::PANNING_DEFAULT, 2);
+}
+
+auto ChipSet::reset() -> void
+{
+    for(auto& chip : _chips) {
+        chip->reset();
+    }
+    _remainder = 0;
+}
+
+auto ChipSet::configure(Panning panning, uint32_t outputs) -> void
+{
+    _panning = panning;
+    _mixer.configure(_panning, outputs, static_cast<uint32_t>(_active));
+}
+
+auto ChipSet::set_active(size_t count) -> void
+{
+    if((count == 0) || (count > _chips.size())) {
+        throw std::runtime_error("invalid number of active chips");
+    }
+    if(_active != count) {
+        _active = count;
+        _mixer.configure(_panning, _mixer.get_outputs(), static_cast<uint32_t>(_active));
+    }
+}
+
+auto ChipSet::render(float* const* outputs, size_t samples, uint32_t clock, uint32_t rate) -> void
+{
+    return synthesize(outputs, samples, clock, rate);
+}
+
+auto ChipSet::render(int32_t* const* outputs, size_t samples, uint32_t clock, uint32_t rate) -> void
+{
+    return synthesize(outputs, samples, clock, rate);
+}
+
+auto ChipSet::get_gain(uint32_t output, uint32_t input) const -> float
+{
+    return _mixer.get_gain(output, input);
+}
+
+auto ChipSet::set_gain(uint32_t output, uint32_t input, float gain) -> void
+{
+    return _mixer.set_gain(output, input, gain);
+}
+
+template <typename T>
+auto ChipSet::synthesize(T* const* outputs, size_t samples, uint32_t clock, uint32_t rate) -> void
+{
+    const uint32_t quotient = (clock / rate);
+    const uint32_t modulus  = (clock % rate);
+    const uint32_t channels = _mixer.get_outputs();
+    const size_t   chips    = _active;
+    uint32_t       elapsed  = 0;
+    uint32_t       horizon  = 0;
+    size_t         offset   = 0;
+    uint32_t       synced[MAX_CHIPS];
+    uint32_t       deadline[MAX_CHIPS];
+    BasicOutput<T> inputs[MAX_CHIPS];
+    T              current[MAX_OUTPUTS];
+    T*             lanes[MAX_OUTPUTS] = {
+        &current[0],
+        &current[1],
+        &current[2],
+        &current[3],
+    };
+
+    auto mix = [&]() -> void
+    {
+        _mixer.mix(inputs, lanes, 1);
+    };
+
+    auto emit = [&](const size_t count) -> void
+    {
+        for(uint32_t channel = 0; channel < channels; ++channel) {
+            static_cast<void>(std::fill_n(outputs[channel] + offset, count, current[channel]));
+        }
+        offset += count;
+    };
+
+    auto sync = [&](const size_t index) -> void
+    {
+        Emulator& chip(*_chips[index]);
+        if(synced[index] != elapsed) {
+            chip.advance(elapsed - synced[index]);
+            synced[index] = elapsed;
+        }
+        deadline[index] = elapsed + chip.get_horizon();
+        ChipSetTraits::get_output(chip, inputs[index]);
+    };
+
+    auto get_horizon = [&]() -> uint32_t
+    {
+        uint32_t result = UINT32_MAX;
+        for(size_t index = 0; index < chips; ++index) {
+            result = std::min(result, deadline[index]);
+        }
+        return (result - elapsed);
+    };
+
+    auto setup = [&]() -> void
+    {
+        for(size_t index = 0; index < chips; ++index) {
+            Emulator& chip(*_chips[index]);
+            synced[index]   = 0;
+            deadline[index] = (8 - (chip->ticks & 0x07));
+            ChipSetTraits::get_output(chip, inputs[index]);
+        }
+        horizon = get_horizon();
+        mix();
+    };
+
+    auto fill = [&]() -> void
+    {
+        const uint64_t limit  = (static_cast<uint64_t>(horizon) * rate) - _remainder - 1;
+        uint64_t       length = samples;
+        if(clock != 0) {
+            length = std::min(length, (limit / clock));
+        }
+        if(length != 0) {
+            const uint64_t total = _remainder + (length * clock);
+            const uint32_t ticks = static_cast<uint32_t>(total / rate);
+            _remainder = static_cast<uint32_t>(total % rate);
+            elapsed += ticks;
+            horizon -= ticks;
+            emit(length);
+            samples -= length;
+        }
+    };
+
+    auto process = [&]() -> void
+    {
+        uint32_t ticks = quotient;
+        if((_remainder += modulus) >= rate) {
+            _remainder -= rate;
+            ++ticks;
+        }
+        elapsed += ticks;
+        for(size_t index = 0; index < chips; ++index) {
+            if(deadline[index] <= elapsed) {
+                sync(index);
+            }
+        }
+        horizon = get_horizon();
+        mix();
+        emit(1);
+        --samples;
+    };
+
+    auto flush = [&]() -> void
+    {
+        for(size_t index = 0; index < chips; ++index) {
+            if(synced[index] != elapsed) {
+                _chips[index]->advance(elapsed - synced[index]);
+            }
+        }
+    };
+
+    auto render = [&]() -> void
+    {
+        setup();
+        while(samples != 0) {
+            fill();
+            if(samples != 0) {
+                process();
+            }
+        }
+        flush();
+    };
+
+    return render();
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,101 @@
+/*
+ * aym-chipset.h - Copyright (c) 2023-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __AYM_ChipSet_h__
+#define __AYM_ChipSet_h__
+
+#include "aym-emulator.h"
+#include "aym-kernels.h"
+#include "aym-mixer.h"
+
+// ---------------------------------------------------------------------------
+// aym::ChipSet
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+class ChipSet
+{
+public: // public interface
+    static constexpr size_t MAX_CHIPS   = MixMatrix::MAX_CHIPS;
+    static constexpr size_t MAX_INPUTS  = MixMatrix::MAX_INPUTS;
+    static constexpr size_t MAX_OUTPUTS = Mixer::MAX_OUTPUTS;
+
+    ChipSet(const ChipType type, const size_t count, Interface& interface, const Kernels& kernels);
+
+    ChipSet(ChipSet&&) = delete;
+
+    ChipSet(const ChipSet&) = delete;
+
+    ChipSet& operator=(ChipSet&&) = delete;
+
+    ChipSet& operator=(const ChipSet&) = delete;
+
+    virtual ~ChipSet() = default;
+
+    auto reset() -> void;
+
+    auto configure(Panning panning, uint32_t outputs) -> void;
+
+    auto set_active(size_t count) -> void;
+
+    auto render(float* const* outputs, size_t samples, uint32_t clock, uint32_t rate) -> void;
+
+    auto render(int32_t* const* outputs, size_t samples, uint32_t clock, uint32_t rate) -> void;
+
+    auto get_gain(uint32_t output, uint32_t input) const -> float;
+
+    auto set_gain(uint32_t output, uint32_t input, float gain) -> void;
+
+    auto get_outputs() const -> uint32_t
+    {
+        return _mixer.get_outputs();
+    }
+
+    auto get_count() const -> size_t
+    {
+        return _chips.size();
+    }
+
+    auto get_active() const -> size_t
+    {
+        return _active;
+    }
+
+    auto operator[](const size_t index) -> Emulator&
+    {
+        return *_chips[index];
+    }
+
+protected: // protected interface
+    template <typename T>
+    auto synthesize(T* const* outputs, size_t samples, uint32_t clock, uint32_t rate) -> void;
+
+protected: // protected data
+    std::vector<std::unique_ptr<Emulator>> _chips;
+    size_t                                 _active;
+    Panning                                _panning;
+    uint32_t                               _remainder;
+    Mixer                                  _mixer;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __AYM_ChipSet_h__ */
@@ -27,7 +27,9 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <algorithm>
 #include <stdexcept>
+#include <type_traits>
 #include "aym-emulator.h"
 
 // ---------------------------------------------------------------------------
@@ -38,14 +40,22 @@ namespace {
 
 struct BasicTraits
 {
-    using ChipType  = aym::ChipType;
-    using State     = aym::State;
-    using Sound     = aym::Sound;
-    using Noise     = aym::Noise;
-    using Envelope  = aym::Envelope;
-    using Output    = aym::Output;
-    using Emulator  = aym::Emulator;
-    using Interface = aym::Interface;
+    using ChipType    = aym::ChipType;
+    using OutputStage = aym::OutputStage;
+    using State       = aym::State;
+    using Sound       = aym::Sound;
+    using Noise       = aym::Noise;
+    using Envelope    = aym::Envelope;
+    using Output      = aym::Output;
+    using OutputLevel = aym::OutputLevel;
+    using OutputInt32 = aym::OutputInt32;
+    using Write       = aym::Write;
+    using WriteQueue  = aym::WriteQueue;
+    using Snapshot    = aym::Snapshot;
+    using Emulator    = aym::Emulator;
+
+    template <typename T>
+    using BasicOutput = aym::BasicOutput<T>;
 
     static constexpr uint8_t ADDRESS_REGISTER      = -1;
     static constexpr uint8_t CHANNEL_A_FINE_TUNE   =  0;
@@ -77,7 +87,29 @@ struct BasicTraits
 
     static const float   ay_dac[32];
     static const float   ym_dac[32];
+    static const int16_t ay_dac_int16[32];
+    static const int16_t ym_dac_int16[32];
     static const uint8_t cycles[16][2];
+    static const uint8_t envelopes[16][96];
+    static const uint8_t masks[16];
+    static const uint32_t jumps[17][17];
+
+    static inline auto advance_counter(uint16_t& counter, const uint32_t period, const uint32_t steps) -> uint32_t
+    {
+        const uint32_t first = (counter < period ? period - counter : 1);
+
+        if(steps < first) {
+            counter += steps;
+            return 0;
+        }
+        const uint32_t rest = steps - first;
+        if(rest < period) {
+            counter = rest;
+            return 1;
+        }
+        counter = (rest % period);
+        return 1 + (rest / period);
+    }
 };
 
 const float BasicTraits::ay_dac[32] = {
@@ -102,6 +134,20 @@ const float BasicTraits::ym_dac[32] = {
     0.6351720f, 0.7580072f, 0.8799268f, 1.0000000f
 };
 
+const int16_t BasicTraits::ay_dac_int16[32] = {
+        0,     0,   327,   327,   473,   473,   690,   690,
+     1006,  1006,  1492,  1492,  2113,  2113,  3518,  3518,
+     4148,  4148,  6717,  6717,  9575,  9575, 12217, 12217,
+    16139, 16139, 20818, 20818, 26397, 26397, 32767, 32767
+};
+
+const int16_t BasicTraits::ym_dac_int16[32] = {
+        0,     0,   152,   253,   359,   457,   557,   656,
+      798,   973,  1149,  1323,  1590,  1911,  2230,  2548,
+     3031,  3640,  4251,  4865,  5789,  6932,  8073,  9211,
+    10935, 13121, 15315, 17512, 20813, 24838, 28833, 32767
+};
+
 const uint8_t BasicTraits::cycles[16][2] = {
     { RAMP_DOWN, HOLD_DOWN },
     { RAMP_DOWN, HOLD_DOWN },
@@ -121,32 +167,417 @@ const uint8_t BasicTraits::cycles[16][2] = {
     { RAMP_UP  , HOLD_DOWN },
 };
 
+const uint8_t BasicTraits::envelopes[16][96] = {
+    { /* shape  0 */
+        0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10,
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    { /* shape  1 */
+        0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10,
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    { /* shape  2 */
+        0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10,
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    { /* shape  3 */
+        0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10,
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    { /* shape  4 */
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    { /* shape  5 */
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    { /* shape  6 */
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    { /* shape  7 */
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    { /* shape  8 */
+        0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10,
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00,
+        0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10,
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00,
+        0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10,
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00
+    },
+    { /* shape  9 */
+        0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10,
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    { /* shape 10 */
+        0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10,
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00,
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+        0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10,
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00
+    },
+    { /* shape 11 */
+        0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10,
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00,
+        0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f,
+        0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f,
+        0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f,
+        0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f
+    },
+    { /* shape 12 */
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+    },
+    { /* shape 13 */
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+        0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f,
+        0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f,
+        0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f,
+        0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f
+    },
+    { /* shape 14 */
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+        0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10,
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00,
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+    },
+    { /* shape 15 */
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    }
+};
+
+const uint32_t BasicTraits::jumps[17][17] = {
+    { 0x10000, 0x00001, 0x00002, 0x10004, 0x00008, 0x00010, 0x00020, 0x00040, 0x00080, 0x00100, 0x00200, 0x00400, 0x00800, 0x01000, 0x02000, 0x04000, 0x08000 },
+    { 0x08000, 0x10000, 0x00001, 0x08002, 0x10004, 0x00008, 0x00010, 0x00020, 0x00040, 0x00080, 0x00100, 0x00200, 0x00400, 0x00800, 0x01000, 0x02000, 0x04000 },
+    { 0x02000, 0x04000, 0x08000, 0x12000, 0x04001, 0x08002, 0x10004, 0x00008, 0x00010, 0x00020, 0x00040, 0x00080, 0x00100, 0x00200, 0x00400, 0x00800, 0x01000 },
+    { 0x00200, 0x00400, 0x00800, 0x01200, 0x02400, 0x04800, 0x09000, 0x12000, 0x04001, 0x08002, 0x10004, 0x00008, 0x00010, 0x00020, 0x00040, 0x00080, 0x00100 },
+    { 0x08002, 0x10004, 0x00008, 0x08012, 0x10024, 0x00048, 0x00090, 0x00120, 0x00240, 0x00480, 0x00900, 0x01200, 0x02400, 0x04800, 0x09000, 0x12000, 0x04001 },
+    { 0x02004, 0x04009, 0x08012, 0x12020, 0x04041, 0x08082, 0x10104, 0x00208, 0x00410, 0x00820, 0x01040, 0x02080, 0x04100, 0x08200, 0x10400, 0x00801, 0x01002 },
+    { 0x00212, 0x00424, 0x00849, 0x01280, 0x02500, 0x04a00, 0x09400, 0x12800, 0x05001, 0x0a002, 0x14004, 0x08008, 0x10010, 0x00021, 0x00042, 0x00084, 0x00109 },
+    { 0x08126, 0x1024d, 0x0049a, 0x08812, 0x11024, 0x02048, 0x04090, 0x08120, 0x10240, 0x00481, 0x00902, 0x01204, 0x02409, 0x04812, 0x09024, 0x12049, 0x04093 },
+    { 0x10496, 0x0092c, 0x01259, 0x12024, 0x04048, 0x08090, 0x10120, 0x00241, 0x00482, 0x00904, 0x01209, 0x02412, 0x04824, 0x09049, 0x12092, 0x04125, 0x0824b },
+    { 0x0c93e, 0x1927d, 0x124fa, 0x080cb, 0x10196, 0x0032c, 0x00659, 0x00cb2, 0x01964, 0x032c9, 0x06592, 0x0cb24, 0x19649, 0x12c93, 0x05927, 0x0b24f, 0x1649f },
+    { 0x10dde, 0x01bbc, 0x03779, 0x1632c, 0x0c658, 0x18cb0, 0x11961, 0x032c3, 0x06586, 0x0cb0d, 0x1961b, 0x12c37, 0x0586e, 0x0b0dd, 0x161bb, 0x0c377, 0x186ef },
+    { 0x1fb56, 0x1f6ac, 0x1ed58, 0x021e7, 0x043cf, 0x0879f, 0x10f3f, 0x01e7e, 0x03cfd, 0x079fb, 0x0f3f6, 0x1e7ed, 0x1cfda, 0x19fb5, 0x13f6a, 0x07ed5, 0x0fdab },
+    { 0x11994, 0x03328, 0x06650, 0x1d534, 0x1aa68, 0x154d1, 0x0a9a3, 0x15346, 0x0a68c, 0x14d19, 0x09a33, 0x13466, 0x068cc, 0x0d199, 0x1a332, 0x14665, 0x08cca },
+    { 0x1e992, 0x1d325, 0x1a64a, 0x0a507, 0x14a0f, 0x0941e, 0x1283d, 0x0507a, 0x0a0f4, 0x141e9, 0x083d3, 0x107a6, 0x00f4c, 0x01e99, 0x03d32, 0x07a64, 0x0f4c9 },
+    { 0x1c304, 0x18608, 0x10c11, 0x1db27, 0x1b64e, 0x16c9c, 0x0d938, 0x1b270, 0x164e1, 0x0c9c3, 0x19386, 0x1270c, 0x04e18, 0x09c30, 0x13860, 0x070c1, 0x0e182 },
+    { 0x10810, 0x01021, 0x02042, 0x14894, 0x09128, 0x12250, 0x044a1, 0x08942, 0x11284, 0x02508, 0x04a10, 0x09420, 0x12840, 0x05081, 0x0a102, 0x14204, 0x08408 },
+    { 0x08100, 0x10200, 0x00401, 0x08902, 0x11204, 0x02408, 0x04810, 0x09020, 0x12040, 0x04081, 0x08102, 0x10204, 0x00408, 0x00810, 0x01020, 0x02040, 0x04080 }
+};
+
+const uint8_t BasicTraits::masks[16] = {
+    0xff, 0x0f, 0xff, 0x0f,
+    0xff, 0x0f, 0x1f, 0xff,
+    0x1f, 0x1f, 0x1f, 0xff,
+    0xff, 0x0f, 0xff, 0xff
+};
+
 }
 
 // ---------------------------------------------------------------------------
-// <anonymous>::StateTraits
+// <anonymous>::MixedTraits
 // ---------------------------------------------------------------------------
 
 namespace {
 
-struct StateTraits final
+struct MixedTraits final
     : public BasicTraits
 {
-    static inline auto construct(State& state, const ChipType type) -> void
+    /*
+     * the three channel outputs are tied together on a shared load: each
+     * channel is modelled as its DAC voltage behind a source conductance
+     * that grows with the level, so loud channels dominate the sum; every
+     * channel still reports its own share of the common voltage, so the
+     * downstream panning keeps working
+     */
+
+    static constexpr double source_min = 0.05;
+    static constexpr double source_max = 1.00;
+    static constexpr double load       = 2.00;
+
+    struct Tables
     {
-        switch(state.type = type) {
-            case ChipType::CHIP_AY8910:
-            case ChipType::CHIP_AY8912:
-            case ChipType::CHIP_AY8913:
-                static_cast<void>(::memcpy(state.dac, ay_dac, sizeof(state.dac)));
-                break;
+        BasicOutput<float>   ay_f32[16 * 16 * 16];
+        BasicOutput<float>   ym_f32[32 * 32 * 32];
+        BasicOutput<int16_t> ay_s16[16 * 16 * 16];
+        BasicOutput<int16_t> ym_s16[32 * 32 * 32];
+
+        Tables()
+        {
+            generate(ay_dac, 16, 2, ay_f32, ay_s16);
+            generate(ym_dac, 32, 1, ym_f32, ym_s16);
+        }
+    };
+
+    static const Tables tables;
+
+    static inline auto get_source(const double level) -> double
+    {
+        return source_min + ((source_max - source_min) * level);
+    }
+
+    static inline auto get_scale(const double level0, const double level1, const double level2) -> double
+    {
+        return 1.0 / (get_source(level0) + get_source(level1) + get_source(level2) + load);
+    }
+
+    static inline auto get_share(const float weight, const float scale) -> int16_t
+    {
+        return static_cast<int16_t>(std::min(static_cast<int32_t>((weight * scale * 32767.0f) + 0.5f), 32767));
+    }
+
+    static inline auto generate(const float* dac, const int levels, const int stride, BasicOutput<float>* table_f32, BasicOutput<int16_t>* table_s16) -> void
+    {
+        const double full = get_source(1.0) * get_scale(1.0, 0.0, 0.0);
+        float        weight[32];
+
+        for(int level = 0; level < levels; ++level) {
+            const double value = dac[level * stride];
+            weight[level] = static_cast<float>((get_source(value) * value) / full);
+        }
+        for(int level0 = 0; level0 < levels; ++level0) {
+            for(int level1 = 0; level1 < levels; ++level1) {
+                for(int level2 = 0; level2 < levels; ++level2) {
+                    const int   index = (((level0 * levels) + level1) * levels) + level2;
+                    const float scale = static_cast<float>(get_scale(dac[level0 * stride], dac[level1 * stride], dac[level2 * stride]));
+                    table_f32[index].channel0 = weight[level0] * scale;
+                    table_f32[index].channel1 = weight[level1] * scale;
+                    table_f32[index].channel2 = weight[level2] * scale;
+                    table_s16[index].channel0 = get_share(weight[level0], scale);
+                    table_s16[index].channel1 = get_share(weight[level1], scale);
+                    table_s16[index].channel2 = get_share(weight[level2], scale);
+                }
+            }
+        }
+    }
+};
+
+const MixedTraits::Tables MixedTraits::tables;
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::ChipTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct AyChipTraits final
+    : public BasicTraits
+{
+    static constexpr uint8_t level_mask = 0x1e;
+
+    static inline auto mix(Output& output, const uint8_t level0, const uint8_t level1, const uint8_t level2) -> void
+    {
+        output.channel0 = ay_dac[level0 & level_mask];
+        output.channel1 = ay_dac[level1 & level_mask];
+        output.channel2 = ay_dac[level2 & level_mask];
+    }
+
+    static inline auto mix(OutputInt32& output, const uint8_t level0, const uint8_t level1, const uint8_t level2) -> void
+    {
+        output.channel0 = ay_dac_int16[level0 & level_mask];
+        output.channel1 = ay_dac_int16[level1 & level_mask];
+        output.channel2 = ay_dac_int16[level2 & level_mask];
+    }
+
+    static inline auto mix(OutputLevel& output, const uint8_t level0, const uint8_t level1, const uint8_t level2) -> void
+    {
+        output.channel0 = (level0 & level_mask);
+        output.channel1 = (level1 & level_mask);
+        output.channel2 = (level2 & level_mask);
+    }
+};
+
+struct YmChipTraits final
+    : public BasicTraits
+{
+    static constexpr uint8_t level_mask = 0x1f;
+
+    static inline auto mix(Output& output, const uint8_t level0, const uint8_t level1, const uint8_t level2) -> void
+    {
+        output.channel0 = ym_dac[level0 & level_mask];
+        output.channel1 = ym_dac[level1 & level_mask];
+        output.channel2 = ym_dac[level2 & level_mask];
+    }
+
+    static inline auto mix(OutputInt32& output, const uint8_t level0, const uint8_t level1, const uint8_t level2) -> void
+    {
+        output.channel0 = ym_dac_int16[level0 & level_mask];
+        output.channel1 = ym_dac_int16[level1 & level_mask];
+        output.channel2 = ym_dac_int16[level2 & level_mask];
+    }
+
+    static inline auto mix(OutputLevel& output, const uint8_t level0, const uint8_t level1, const uint8_t level2) -> void
+    {
+        output.channel0 = (level0 & level_mask);
+        output.channel1 = (level1 & level_mask);
+        output.channel2 = (level2 & level_mask);
+    }
+};
+
+struct AyMixedChipTraits final
+    : public BasicTraits
+{
+    static constexpr uint8_t level_mask = 0x1e;
+
+    static inline auto get_index(const uint8_t level0, const uint8_t level1, const uint8_t level2) -> uint32_t
+    {
+        return ((level0 & level_mask) << 7)
+             | ((level1 & level_mask) << 3)
+             | ((level2 & level_mask) >> 1)
+             ;
+    }
+
+    static inline auto mix(Output& output, const uint8_t level0, const uint8_t level1, const uint8_t level2) -> void
+    {
+        output = MixedTraits::tables.ay_f32[get_index(level0, level1, level2)];
+    }
+
+    static inline auto mix(OutputInt32& output, const uint8_t level0, const uint8_t level1, const uint8_t level2) -> void
+    {
+        const auto& share(MixedTraits::tables.ay_s16[get_index(level0, level1, level2)]);
+
+        output.channel0 = share.channel0;
+        output.channel1 = share.channel1;
+        output.channel2 = share.channel2;
+    }
+
+    static inline auto mix(OutputLevel& output, const uint8_t level0, const uint8_t level1, const uint8_t level2) -> void
+    {
+        output.channel0 = (level0 & level_mask);
+        output.channel1 = (level1 & level_mask);
+        output.channel2 = (level2 & level_mask);
+    }
+};
+
+struct YmMixedChipTraits final
+    : public BasicTraits
+{
+    static constexpr uint8_t level_mask = 0x1f;
+
+    static inline auto get_index(const uint8_t level0, const uint8_t level1, const uint8_t level2) -> uint32_t
+    {
+        return ((level0 & level_mask) << 10)
+             | ((level1 & level_mask) <<  5)
+             | ((level2 & level_mask) <<  0)
+             ;
+    }
+
+    static inline auto mix(Output& output, const uint8_t level0, const uint8_t level1, const uint8_t level2) -> void
+    {
+        output = MixedTraits::tables.ym_f32[get_index(level0, level1, level2)];
+    }
+
+    static inline auto mix(OutputInt32& output, const uint8_t level0, const uint8_t level1, const uint8_t level2) -> void
+    {
+        const auto& share(MixedTraits::tables.ym_s16[get_index(level0, level1, level2)]);
+
+        output.channel0 = share.channel0;
+        output.channel1 = share.channel1;
+        output.channel2 = share.channel2;
+    }
+
+    static inline auto mix(OutputLevel& output, const uint8_t level0, const uint8_t level1, const uint8_t level2) -> void
+    {
+        output.channel0 = (level0 & level_mask);
+        output.channel1 = (level1 & level_mask);
+        output.channel2 = (level2 & level_mask);
+    }
+};
+
+struct ChipTraits final
+    : public BasicTraits
+{
+    template <typename Function>
+    static inline auto dispatch(const State& state, Function&& function) -> void
+    {
+        const bool mixed = (state.stage == OutputStage::OUTPUT_STAGE_MIXED);
+
+        switch(state.type) {
             case ChipType::CHIP_YM2149:
-                static_cast<void>(::memcpy(state.dac, ym_dac, sizeof(state.dac)));
-                break;
+                if(mixed) {
+                    return function(YmMixedChipTraits());
+                }
+                return function(YmChipTraits());
             default:
-                static_cast<void>(::memcpy(state.dac, ay_dac, sizeof(state.dac)));
                 break;
         }
+        if(mixed) {
+            return function(AyMixedChipTraits());
+        }
+        return function(AyChipTraits());
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::StateTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct StateTraits final
+    : public BasicTraits
+{
+    static inline auto construct(State& state, const ChipType type) -> void
+    {
+        state.type  = type;
+        state.stage = OutputStage::OUTPUT_STAGE_LINEAR;
     }
 
     static inline auto destruct(State& state) -> void
@@ -155,8 +586,9 @@ struct StateTraits final
 
     static inline auto reset(State& state) -> void
     {
-        state.ticks &= 0;
-        state.index &= 0;
+        state.ticks     &= 0;
+        state.remainder &= 0;
+        state.index     &= 0;
         for(auto& value : state.array) {
             value &= 0;
         }
@@ -189,38 +621,6 @@ struct StateTraits final
 
         return value;
     }
-
-    static inline auto get_port0(State& state, Emulator& emulator, Interface& interface, const uint8_t value) -> uint8_t
-    {
-        if(state.dir_port[PORT0] == 0) {
-            return interface.aym_port_a_rd(emulator, value);
-        }
-        return value;
-    }
-
-    static inline auto set_port0(State& state, Emulator& emulator, Interface& interface, const uint8_t value) -> uint8_t
-    {
-        if(state.dir_port[PORT0] != 0) {
-            return interface.aym_port_a_wr(emulator, value);
-        }
-        return value;
-    }
-
-    static inline auto get_port1(State& state, Emulator& emulator, Interface& interface, const uint8_t value) -> uint8_t
-    {
-        if(state.dir_port[PORT1] == 0) {
-            return interface.aym_port_b_rd(emulator, value);
-        }
-        return value;
-    }
-
-    static inline auto set_port1(State& state, Emulator& emulator, Interface& interface, const uint8_t value) -> uint8_t
-    {
-        if(state.dir_port[PORT1] != 0) {
-            return interface.aym_port_b_wr(emulator, value);
-        }
-        return value;
-    }
 };
 
 }
@@ -253,6 +653,24 @@ struct SoundTraits final
         }
     }
 
+    static inline auto advance(Sound& sound, const uint32_t steps) -> void
+    {
+        if(sound.period == 0) {
+            return;
+        }
+        const uint32_t flips = advance_counter(sound.counter, sound.period, steps);
+
+        sound.phase ^= (flips & 1);
+    }
+
+    static inline auto fixup(const Sound& lhs, Sound& rhs) -> void
+    {
+        if((lhs.period == rhs.period) && (lhs.counter != rhs.counter)) {
+            rhs.counter = lhs.counter;
+            rhs.phase   = lhs.phase;
+        }
+    }
+
     static inline auto get_fine_tune(Sound& sound, const uint8_t value) -> uint8_t
     {
         return value;
@@ -318,6 +736,41 @@ struct NoiseTraits final
         noise.phase   &= 0;
     }
 
+    static inline auto shift(Noise& noise) -> void
+    {
+        const uint32_t lfsr = noise.shift;
+        const uint32_t bit0 = (lfsr << 16);
+        const uint32_t bit3 = (lfsr << 13);
+        const uint32_t msw  = (~(bit0 ^ bit3) & 0x10000);
+        const uint32_t lsw  = ((lfsr >> 1) & 0x0ffff);
+        noise.shift = (msw | lsw);
+        noise.phase = (lfsr & 1);
+    }
+
+    static inline auto jump(Noise& noise, const uint32_t shifts) -> void
+    {
+        uint32_t count = ((shifts - 1) % 131071);
+        uint32_t state = (~noise.shift & 0x1ffff);
+
+        auto multiply = [](const uint32_t (&matrix)[17], uint32_t vector) -> uint32_t
+        {
+            uint32_t result = 0;
+            while(vector != 0) {
+                result ^= matrix[__builtin_ctz(vector)];
+                vector &= (vector - 1);
+            }
+            return result;
+        };
+
+        for(int power = 0; count != 0; ++power, count >>= 1) {
+            if((count & 1) != 0) {
+                state = multiply(jumps[power], state);
+            }
+        }
+        noise.shift = (~state & 0x1ffff);
+        shift(noise);
+    }
+
     static inline auto clock(Noise& noise) -> void
     {
         if(noise.period == 0) {
@@ -325,16 +778,32 @@ struct NoiseTraits final
         }
         if(++noise.counter >= noise.period) {
             noise.counter &= 0;
-            const uint32_t lfsr = noise.shift;
-            const uint32_t bit0 = (lfsr << 16);
-            const uint32_t bit3 = (lfsr << 13);
-            const uint32_t msw  = (~(bit0 ^ bit3) & 0x10000);
-            const uint32_t lsw  = ((lfsr >> 1) & 0x0ffff);
-            noise.shift = (msw | lsw);
-            noise.phase = (lfsr & 1);
+            shift(noise);
         }
     }
 
+    static inline auto advance(Noise& noise, const uint32_t steps) -> void
+    {
+        if(noise.period == 0) {
+            return;
+        }
+        uint32_t shifts = advance_counter(noise.counter, noise.period, steps);
+        if(shifts >= 32) {
+            return jump(noise, shifts);
+        }
+        for(; shifts != 0; --shifts) {
+            shift(noise);
+        }
+    }
+
+    static inline auto get_distance(const Noise& noise) -> uint32_t
+    {
+        const uint32_t toggle = (noise.phase != 0 ? 0x1ffff : 0x00000);
+        const uint32_t change = ((noise.shift ^ toggle) & 0x1ffff);
+
+        return (change != 0 ? __builtin_ctz(change) : 16);
+    }
+
     static inline auto get_fine_tune(Noise& sound, const uint8_t value) -> uint8_t
     {
         return value;
@@ -379,42 +848,44 @@ struct EnvelopeTraits final
 {
     static inline auto reset(Envelope& envelope) -> void
     {
-        envelope.counter   &= 0;
-        envelope.period    &= 0;
-        envelope.shape     &= 0;
-        envelope.phase     &= 0;
-        envelope.amplitude &= 0;
+        envelope.counter  &= 0;
+        envelope.period   &= 0;
+        envelope.shape    &= 0;
+        envelope.position  = 32;
+    }
+
+    static inline auto get_amplitude(const Envelope& envelope) -> uint8_t
+    {
+        return envelopes[envelope.shape][envelope.position];
+    }
+
+    static inline auto is_holding(const Envelope& envelope) -> bool
+    {
+        return (envelope.position >= 32) && (cycles[envelope.shape][1] >= HOLD_UP);
+    }
+
+    static inline auto step(Envelope& envelope) -> void
+    {
+        envelope.position = (envelope.position < 95 ? envelope.position + 1 : 32);
     }
 
     static inline auto clock(Envelope& envelope) -> void
     {
         if(++envelope.counter >= envelope.period) {
             envelope.counter &= 0;
-            switch(cycles[envelope.shape][envelope.phase]) {
-                case RAMP_UP:
-                    envelope.amplitude = ((envelope.amplitude + 1) & 0x1f);
-                    if(envelope.amplitude == 0x1f) {
-                        envelope.phase ^= 1;
-                    }
-                    break;
-                case RAMP_DOWN:
-                    envelope.amplitude = ((envelope.amplitude - 1) & 0x1f);
-                    if(envelope.amplitude == 0x00) {
-                        envelope.phase ^= 1;
-                    }
-                    break;
-                case HOLD_UP:
-                    envelope.amplitude = 0x1f;
-                    break;
-                case HOLD_DOWN:
-                    envelope.amplitude = 0x00;
-                    break;
-                default:
-                    break;
-            }
+            step(envelope);
         }
     }
 
+    static inline auto advance(Envelope& envelope, const uint32_t steps) -> void
+    {
+        const uint32_t period   = (envelope.period != 0 ? envelope.period : 1);
+        const uint32_t cycles   = advance_counter(envelope.counter, period, steps);
+        const uint32_t position = envelope.position + cycles;
+
+        envelope.position = (position < 96 ? position : 32 + ((position - 32) % 64));
+    }
+
     static inline auto get_fine_tune(Envelope& envelope, const uint8_t value) -> uint8_t
     {
         return value;
@@ -452,9 +923,8 @@ struct EnvelopeTraits final
 
     static inline auto set_shape(Envelope& envelope, const uint8_t value) -> uint8_t
     {
-        envelope.shape     = value;
-        envelope.phase     = 0;
-        envelope.amplitude = ((envelope.shape & 0x04) == 0 ? 0x1f : 0x00);
+        envelope.shape    = value;
+        envelope.position = 0;
 
         return value;
     }
@@ -477,97 +947,848 @@ struct OutputTraits final
         output.channel1 = 0.0f;
         output.channel2 = 0.0f;
     }
-};
 
-}
+    static inline auto get_level(const State& state, const Sound& sound, const Noise& noise, const Envelope& envelope, const int index) -> uint8_t
+    {
+        const uint8_t has_sound = state.has_sound[index];
+        const uint8_t has_noise = state.has_noise[index];
+        const uint8_t sig_sound = (has_sound != 0 ? sound.phase : 1);
+        const uint8_t sig_noise = (has_noise != 0 ? noise.phase : 1);
+        const uint8_t amplitude = (sound.amplitude & 0x20 ? EnvelopeTraits::get_amplitude(envelope) : (sound.amplitude & 0x1f));
+        const uint8_t output    = (sig_sound & sig_noise);
 
-// ---------------------------------------------------------------------------
-// aym::Emulator
-// ---------------------------------------------------------------------------
+        return (amplitude & static_cast<uint8_t>(-output));
+    }
 
-namespace aym {
+    template <typename Chip, typename T>
+    static inline auto update(BasicOutput<T>& output, const State& state, const Sound (&sound)[3], const Noise (&noise)[1], const Envelope& envelope) -> void
+    {
+        const uint8_t level0 = get_level(state, sound[SOUND0], noise[NOISE0], envelope, SOUND0);
+        const uint8_t level1 = get_level(state, sound[SOUND1], noise[NOISE0], envelope, SOUND1);
+        const uint8_t level2 = get_level(state, sound[SOUND2], noise[NOISE0], envelope, SOUND2);
 
-Emulator::Emulator(const ChipType type, Interface& interface)
-    : _interface(interface)
-    , _state()
-    , _sound()
-    , _noise()
-    , _envelope()
-    , _output()
-{
-    StateTraits::construct(_state, type);
+        Chip::mix(output, level0, level1, level2);
+    }
+};
 
-    reset();
 }
 
-Emulator::~Emulator()
-{
-    StateTraits::destruct(_state);
-}
+// ---------------------------------------------------------------------------
+// <anonymous>::QueueTraits
+// ---------------------------------------------------------------------------
 
-void Emulator::reset()
-{
-    StateTraits::reset(_state);
-    SoundTraits::reset(_sound[BasicTraits::SOUND0]);
-    SoundTraits::reset(_sound[BasicTraits::SOUND1]);
-    SoundTraits::reset(_sound[BasicTraits::SOUND2]);
-    NoiseTraits::reset(_noise[BasicTraits::NOISE0]);
-    EnvelopeTraits::reset(_envelope);
-    OutputTraits::reset(_output);
-}
+namespace {
 
-void Emulator::clock()
+struct QueueTraits final
+    : public BasicTraits
 {
-    auto fixup = [&](Sound& lhs, Sound& rhs) -> void
+    static inline auto reset(WriteQueue& queue) -> void
     {
-        if((lhs.period == rhs.period) && (lhs.counter != rhs.counter)) {
-            rhs.counter = lhs.counter;
-            rhs.phase   = lhs.phase;
-        }
-    };
+        queue.head  = 0;
+        queue.tail  = 0;
+        queue.stale = 0;
+    }
 
-    auto prepare = [&]() -> void
+    static inline auto is_empty(const WriteQueue& queue) -> bool
     {
-        fixup(_sound[0], _sound[1]);
-        fixup(_sound[0], _sound[2]);
-        fixup(_sound[1], _sound[2]);
-    };
+        return (queue.head == queue.tail);
+    }
 
-    auto get_output = [&](const int sound_index, const int noise_index) -> float
+    static inline auto is_full(const WriteQueue& queue) -> bool
     {
-        const uint8_t has_sound = _state.has_sound[sound_index];
-        const uint8_t has_noise = _state.has_noise[sound_index];
-        const uint8_t sig_sound = (has_sound != 0 ? _sound[sound_index].phase : 1);
-        const uint8_t sig_noise = (has_noise != 0 ? _noise[noise_index].phase : 1);
-        const uint8_t amplitude = (_sound[sound_index].amplitude & 0x20 ? (_envelope.amplitude & 0x1f) : (_sound[sound_index].amplitude & 0x1f));
-        const uint8_t output    = (sig_sound & sig_noise);
-
-        return static_cast<float>(output) * _state.dac[amplitude];
-    };
+        return ((queue.tail - queue.head) >= WriteQueue::SIZE);
+    }
 
-    auto output = [&]() -> void
+    static inline auto push(WriteQueue& queue, const uint32_t ticks, const uint8_t index, const uint8_t value) -> void
     {
-        _output.channel0 = get_output(BasicTraits::SOUND0, BasicTraits::NOISE0);
-        _output.channel1 = get_output(BasicTraits::SOUND1, BasicTraits::NOISE0);
-        _output.channel2 = get_output(BasicTraits::SOUND2, BasicTraits::NOISE0);
-    };
+        Write& write(queue.writes[queue.tail++ % WriteQueue::SIZE]);
 
-    auto update = [&]() -> void
+        write.ticks = ticks;
+        write.index = index;
+        write.value = value;
+    }
+
+    static inline auto pop(WriteQueue& queue) -> const Write&
+    {
+        return queue.writes[queue.head++ % WriteQueue::SIZE];
+    }
+
+    static inline auto get_distance(const WriteQueue& queue, const State& state) -> uint32_t
+    {
+        if(is_empty(queue)) {
+            return UINT32_MAX;
+        }
+        const Write&  write    = queue.writes[queue.head % WriteQueue::SIZE];
+        const int32_t distance = static_cast<int32_t>(write.ticks - state.ticks);
+
+        return (distance > 0 ? static_cast<uint32_t>(distance) : 0);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::SnapshotTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct SnapshotTraits final
+    : public BasicTraits
+{
+    static inline auto copy(State& dst, const State& src) -> void
+    {
+        dst.type      = src.type;
+        dst.stage     = src.stage;
+        dst.ticks     = src.ticks;
+        dst.remainder = src.remainder;
+        dst.index     = src.index;
+        for(int index = 0; index < 16; ++index) {
+            dst.array[index] = src.array[index];
+        }
+        for(int index = 0; index < 3; ++index) {
+            dst.has_sound[index] = src.has_sound[index];
+            dst.has_noise[index] = src.has_noise[index];
+        }
+        for(int index = 0; index < 2; ++index) {
+            dst.dir_port[index] = src.dir_port[index];
+        }
+    }
+
+    static inline auto copy(Sound& dst, const Sound& src) -> void
+    {
+        dst.counter   = src.counter;
+        dst.period    = src.period;
+        dst.phase     = src.phase;
+        dst.amplitude = src.amplitude;
+    }
+
+    static inline auto copy(Noise& dst, const Noise& src) -> void
+    {
+        dst.counter = src.counter;
+        dst.period  = src.period;
+        dst.shift   = src.shift;
+        dst.phase   = src.phase;
+    }
+
+    static inline auto copy(Envelope& dst, const Envelope& src) -> void
+    {
+        dst.counter  = src.counter;
+        dst.period   = src.period;
+        dst.shape    = src.shape;
+        dst.position = src.position;
+    }
+
+    static inline auto copy(Output& dst, const Output& src) -> void
+    {
+        dst.channel0 = src.channel0;
+        dst.channel1 = src.channel1;
+        dst.channel2 = src.channel2;
+    }
+
+    static inline auto copy(Write& dst, const Write& src) -> void
+    {
+        dst.ticks = src.ticks;
+        dst.index = src.index;
+        dst.value = src.value;
+    }
+
+    static inline auto save(Snapshot& snapshot, const WriteQueue& queue) -> void
+    {
+        const uint32_t pending = (queue.tail - queue.head);
+
+        snapshot.stale   = queue.stale;
+        snapshot.pending = pending;
+        for(uint32_t index = 0; index < pending; ++index) {
+            copy(snapshot.writes[index], queue.writes[(queue.head + index) % WriteQueue::SIZE]);
+        }
+    }
+
+    static inline auto restore(const Snapshot& snapshot, WriteQueue& queue) -> void
     {
-        const auto clk_div = ((++_state.ticks) & 0x07);
+        const uint32_t pending = snapshot.pending;
+
+        queue.head  = 0;
+        queue.tail  = pending;
+        queue.stale = snapshot.stale;
+        for(uint32_t index = 0; index < pending; ++index) {
+            copy(queue.writes[index], snapshot.writes[index]);
+        }
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::ClockTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct ClockTraits final
+    : public BasicTraits
+{
+    static inline auto prepare(Sound (&sound)[3]) -> void
+    {
+        SoundTraits::fixup(sound[SOUND0], sound[SOUND1]);
+        SoundTraits::fixup(sound[SOUND0], sound[SOUND2]);
+        SoundTraits::fixup(sound[SOUND1], sound[SOUND2]);
+    }
+
+    template <typename Chip, typename T>
+    static inline auto step(State& state, Sound (&sound)[3], Noise (&noise)[1], Envelope& envelope, BasicOutput<T>& output) -> void
+    {
+        prepare(sound);
+        SoundTraits::clock(sound[SOUND0]);
+        SoundTraits::clock(sound[SOUND1]);
+        SoundTraits::clock(sound[SOUND2]);
+        NoiseTraits::clock(noise[NOISE0]);
+        EnvelopeTraits::clock(envelope);
+        OutputTraits::update<Chip, T>(output, state, sound, noise, envelope);
+    }
+
+    template <typename Chip, typename T>
+    static inline auto clock(State& state, Sound (&sound)[3], Noise (&noise)[1], Envelope& envelope, BasicOutput<T>& output) -> void
+    {
+        const auto clk_div = ((++state.ticks) & 0x07);
 
         if(clk_div == 0) {
-            prepare();
-            SoundTraits::clock(_sound[BasicTraits::SOUND0]);
-            SoundTraits::clock(_sound[BasicTraits::SOUND1]);
-            SoundTraits::clock(_sound[BasicTraits::SOUND2]);
-            NoiseTraits::clock(_noise[BasicTraits::NOISE0]);
-            EnvelopeTraits::clock(_envelope);
-            output();
+            step<Chip, T>(state, sound, noise, envelope, output);
+        }
+    }
+
+    template <typename Chip, typename T>
+    static inline auto advance(State& state, Sound (&sound)[3], Noise (&noise)[1], Envelope& envelope, BasicOutput<T>& output, const uint32_t ticks) -> void
+    {
+        const uint64_t clk_div = ((state.ticks & 0x07) + static_cast<uint64_t>(ticks));
+        const uint32_t steps   = static_cast<uint32_t>(clk_div >> 3);
+
+        state.ticks += ticks;
+        if(steps == 1) {
+            step<Chip, T>(state, sound, noise, envelope, output);
+        }
+        else if(steps != 0) {
+            prepare(sound);
+            SoundTraits::advance(sound[SOUND0], steps);
+            SoundTraits::advance(sound[SOUND1], steps);
+            SoundTraits::advance(sound[SOUND2], steps);
+            NoiseTraits::advance(noise[NOISE0], steps);
+            EnvelopeTraits::advance(envelope, steps);
+            OutputTraits::update<Chip, T>(output, state, sound, noise, envelope);
+        }
+    }
+
+    static inline auto get_horizon(const State& state, const Sound (&sound)[3], const Noise (&noise)[1], const Envelope& envelope) -> uint32_t
+    {
+        constexpr uint32_t infinite = 0x08000000;
+        uint32_t           edges    = infinite;
+        uint8_t            use_env  = 0;
+
+        auto next_edge = [&](const uint32_t counter, const uint32_t period, const uint32_t skips) -> void
+        {
+            const uint32_t distance = (counter < period ? period - counter : 1) + (skips * period);
+            if(edges > distance) {
+                edges = distance;
+            }
+        };
+
+        auto sound_edge = [&](const int index) -> void
+        {
+            const Sound&  channel   = sound[index];
+            const uint8_t amplitude = channel.amplitude;
+            if((amplitude & 0x20) != 0) {
+                use_env |= 1;
+            }
+            else if((amplitude & 0x1f) == 0) {
+                return;
+            }
+            if((state.has_sound[index] != 0) && (channel.period != 0)) {
+                next_edge(channel.counter, channel.period, 0);
+            }
+        };
+
+        auto noise_edge = [&]() -> void
+        {
+            const uint8_t has_noise = (state.has_noise[SOUND0] | state.has_noise[SOUND1] | state.has_noise[SOUND2]);
+            if((has_noise != 0) && (noise[NOISE0].period != 0)) {
+                next_edge(noise[NOISE0].counter, noise[NOISE0].period, NoiseTraits::get_distance(noise[NOISE0]));
+            }
+        };
+
+        auto envelope_edge = [&]() -> void
+        {
+            if(use_env == 0) {
+                return;
+            }
+            if(EnvelopeTraits::is_holding(envelope)) {
+                return;
+            }
+            next_edge(envelope.counter, (envelope.period != 0 ? envelope.period : 1), 0);
+        };
+
+        auto get_horizon = [&]() -> uint32_t
+        {
+            sound_edge(SOUND0);
+            sound_edge(SOUND1);
+            sound_edge(SOUND2);
+            noise_edge();
+            envelope_edge();
+            return (8 - (state.ticks & 0x07)) + ((edges - 1) * 8);
+        };
+
+        return get_horizon();
+    }
+
+    template <typename Chip, typename T, typename Apply>
+    static inline auto consume(State& state, Sound (&sound)[3], Noise (&noise)[1], Envelope& envelope, BasicOutput<T>& output, WriteQueue& queue, Apply&& apply, uint32_t ticks) -> void
+    {
+        uint32_t distance = QueueTraits::get_distance(queue, state);
+
+        while(distance <= ticks) {
+            advance<Chip, T>(state, sound, noise, envelope, output, distance);
+            apply(QueueTraits::pop(queue));
+            queue.stale = 1;
+            ticks   -= distance;
+            distance = QueueTraits::get_distance(queue, state);
+        }
+        if(((state.ticks & 0x07) + static_cast<uint64_t>(ticks)) >= 8) {
+            queue.stale = 0;
+        }
+        advance<Chip, T>(state, sound, noise, envelope, output, ticks);
+    }
+
+    static inline auto get_horizon(const State& state, const Sound (&sound)[3], const Noise (&noise)[1], const Envelope& envelope, const WriteQueue& queue) -> uint32_t
+    {
+        uint32_t horizon = (8 - (state.ticks & 0x07));
+
+        if(queue.stale == 0) {
+            horizon = get_horizon(state, sound, noise, envelope);
+        }
+        return std::min(horizon, std::max(QueueTraits::get_distance(queue, state), 1u));
+    }
+
+    template <typename Chip, typename T, typename Apply>
+    static inline auto skip(State& state, Sound (&sound)[3], Noise (&noise)[1], Envelope& envelope, BasicOutput<T>& output, WriteQueue& queue, Apply&& apply, size_t samples, const uint32_t clock, const uint32_t rate) -> void
+    {
+        constexpr size_t chunk = 65536;
+
+        while(samples != 0) {
+            const size_t   count = std::min(samples, chunk);
+            const uint64_t total = state.remainder + (static_cast<uint64_t>(count) * clock);
+            state.remainder = static_cast<uint32_t>(total % rate);
+            consume<Chip>(state, sound, noise, envelope, output, queue, apply, static_cast<uint32_t>(total / rate));
+            samples -= count;
         }
+    }
+
+    template <typename Chip, typename T, typename Apply, typename Writer>
+    static inline auto render(State& state, Sound (&sound)[3], Noise (&noise)[1], Envelope& envelope, BasicOutput<T>& current, WriteQueue& queue, Apply&& apply, Writer&& write, size_t samples, const uint32_t clock, const uint32_t rate) -> void
+    {
+        const uint32_t quotient = (clock / rate);
+        const uint32_t modulus  = (clock % rate);
+        uint32_t       pending  = 0;
+        uint32_t       horizon  = 0;
+
+        auto start = [&]() -> void
+        {
+            consume<Chip>(state, sound, noise, envelope, current, queue, apply, 0);
+            horizon = std::min((8 - (state.ticks & 0x07)), QueueTraits::get_distance(queue, state));
+        };
+
+        auto fill = [&]() -> void
+        {
+            const uint64_t limit = (static_cast<uint64_t>(horizon) * rate) - state.remainder - 1;
+            uint64_t       count = samples;
+            if(clock != 0) {
+                count = std::min(count, (limit / clock));
+            }
+            if(count != 0) {
+                const uint64_t total = state.remainder + (count * clock);
+                const uint32_t ticks = static_cast<uint32_t>(total / rate);
+                state.remainder = static_cast<uint32_t>(total % rate);
+                pending += ticks;
+                horizon -= ticks;
+                write(current, count);
+                samples -= count;
+            }
+        };
+
+        auto process = [&]() -> void
+        {
+            uint32_t ticks = quotient;
+            if((state.remainder += modulus) >= rate) {
+                state.remainder -= rate;
+                ++ticks;
+            }
+            consume<Chip>(state, sound, noise, envelope, current, queue, apply, (pending + ticks));
+            pending  = 0;
+            horizon  = get_horizon(state, sound, noise, envelope, queue);
+            write(current, 1);
+            --samples;
+        };
+
+        auto flush = [&]() -> void
+        {
+            if(pending != 0) {
+                consume<Chip>(state, sound, noise, envelope, current, queue, apply, pending);
+            }
+        };
+
+        auto render = [&]() -> void
+        {
+            start();
+            while(samples != 0) {
+                fill();
+                if(samples != 0) {
+                    process();
+                }
+            }
+            flush();
+        };
+
+        return render();
+    }
+
+    template <typename Chip, typename T, typename Apply, typename Writer>
+    static inline auto oversample(State& state, Sound (&sound)[3], Noise (&noise)[1], Envelope& envelope, BasicOutput<T>& current, WriteQueue& queue, Apply&& apply, Writer&& write, size_t samples, const uint32_t clock, const uint32_t rate) -> void
+    {
+        uint32_t ticks = 0;
+
+        auto start = [&]() -> void
+        {
+            const uint64_t total = state.remainder + (static_cast<uint64_t>(samples) * clock);
+            state.remainder = static_cast<uint32_t>(total % rate);
+            ticks = static_cast<uint32_t>(total / rate);
+        };
+
+        auto process = [&]() -> void
+        {
+            const uint32_t first = (8 - (state.ticks & 0x07));
+            const uint32_t steps = 1 + ((ticks - first) >> 3);
+            const uint32_t limit = get_horizon(state, sound, noise, envelope, queue);
+            uint32_t       count = 1;
+            if(limit > first) {
+                count = std::min(steps, (1 + ((limit - first - 1) >> 3)));
+            }
+            const uint32_t length = first + ((count - 1) * 8);
+            consume<Chip>(state, sound, noise, envelope, current, queue, apply, length);
+            write(current, count);
+            ticks -= length;
+        };
+
+        auto flush = [&]() -> void
+        {
+            consume<Chip>(state, sound, noise, envelope, current, queue, apply, ticks);
+        };
+
+        auto oversample = [&]() -> void
+        {
+            start();
+            while(ticks >= (8 - (state.ticks & 0x07))) {
+                process();
+            }
+            flush();
+        };
+
+        return oversample();
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::Emulator
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+Emulator::Emulator(const ChipType type, Interface& interface)
+    : _interface(interface)
+    , _state()
+    , _sound()
+    , _noise()
+    , _envelope()
+    , _output()
+    , _queue()
+{
+    StateTraits::construct(_state, type);
+
+    reset();
+}
+
+Emulator::~Emulator()
+{
+    StateTraits::destruct(_state);
+}
+
+void Emulator::reset()
+{
+    StateTraits::reset(_state);
+    SoundTraits::reset(_sound[BasicTraits::SOUND0]);
+    SoundTraits::reset(_sound[BasicTraits::SOUND1]);
+    SoundTraits::reset(_sound[BasicTraits::SOUND2]);
+    NoiseTraits::reset(_noise[BasicTraits::NOISE0]);
+    EnvelopeTraits::reset(_envelope);
+    OutputTraits::reset(_output);
+    QueueTraits::reset(_queue);
+}
+
+void Emulator::clock()
+{
+    auto clock = [&](auto chip) -> void
+    {
+        using Chip = decltype(chip);
+        ClockTraits::clock<Chip>(_state, _sound, _noise, _envelope, _output);
+    };
+
+    return ChipTraits::dispatch(_state, clock);
+}
+
+void Emulator::advance(uint32_t ticks)
+{
+    auto apply = [&](const Write& write) -> void
+    {
+        return write_register(write);
+    };
+
+    auto advance = [&](auto chip) -> void
+    {
+        using Chip = decltype(chip);
+        ClockTraits::consume<Chip>(_state, _sound, _noise, _envelope, _output, _queue, apply, ticks);
     };
 
-    return update();
+    return ChipTraits::dispatch(_state, advance);
+}
+
+void Emulator::render(Output* output, size_t samples, uint32_t clock, uint32_t rate)
+{
+    auto apply = [&](const Write& write) -> void
+    {
+        return write_register(write);
+    };
+
+    auto write = [&](const Output& value, const size_t count) -> void
+    {
+        output = std::fill_n(output, count, value);
+    };
+
+    auto render = [&](auto chip) -> void
+    {
+        using Chip = decltype(chip);
+        ClockTraits::render<Chip>(_state, _sound, _noise, _envelope, _output, _queue, apply, write, samples, clock, rate);
+    };
+
+    return ChipTraits::dispatch(_state, render);
+}
+
+void Emulator::render(OutputInt32* output, size_t samples, uint32_t clock, uint32_t rate)
+{
+    auto apply = [&](const Write& write) -> void
+    {
+        return write_register(write);
+    };
+
+    auto write = [&](const OutputInt32& value, const size_t count) -> void
+    {
+        output = std::fill_n(output, count, value);
+    };
+
+    auto render = [&](auto chip) -> void
+    {
+        using Chip = decltype(chip);
+        OutputInt32 current;
+        OutputTraits::update<Chip>(current, _state, _sound, _noise, _envelope);
+        ClockTraits::render<Chip>(_state, _sound, _noise, _envelope, current, _queue, apply, write, samples, clock, rate);
+        OutputTraits::update<Chip>(_output, _state, _sound, _noise, _envelope);
+    };
+
+    return ChipTraits::dispatch(_state, render);
+}
+
+void Emulator::render(float* channel0, float* channel1, float* channel2, size_t samples, uint32_t clock, uint32_t rate)
+{
+    auto apply = [&](const Write& write) -> void
+    {
+        return write_register(write);
+    };
+
+    auto write = [&](const Output& value, const size_t count) -> void
+    {
+        channel0 = std::fill_n(channel0, count, value.channel0);
+        channel1 = std::fill_n(channel1, count, value.channel1);
+        channel2 = std::fill_n(channel2, count, value.channel2);
+    };
+
+    auto render = [&](auto chip) -> void
+    {
+        using Chip = decltype(chip);
+        ClockTraits::render<Chip>(_state, _sound, _noise, _envelope, _output, _queue, apply, write, samples, clock, rate);
+    };
+
+    return ChipTraits::dispatch(_state, render);
+}
+
+void Emulator::render(int16_t* channel0, int16_t* channel1, int16_t* channel2, size_t samples, uint32_t clock, uint32_t rate)
+{
+    auto apply = [&](const Write& write) -> void
+    {
+        return write_register(write);
+    };
+
+    auto write = [&](const OutputInt32& value, const size_t count) -> void
+    {
+        channel0 = std::fill_n(channel0, count, static_cast<int16_t>(value.channel0));
+        channel1 = std::fill_n(channel1, count, static_cast<int16_t>(value.channel1));
+        channel2 = std::fill_n(channel2, count, static_cast<int16_t>(value.channel2));
+    };
+
+    auto render = [&](auto chip) -> void
+    {
+        using Chip = decltype(chip);
+        OutputInt32 current;
+        OutputTraits::update<Chip>(current, _state, _sound, _noise, _envelope);
+        ClockTraits::render<Chip>(_state, _sound, _noise, _envelope, current, _queue, apply, write, samples, clock, rate);
+        OutputTraits::update<Chip>(_output, _state, _sound, _noise, _envelope);
+    };
+
+    return ChipTraits::dispatch(_state, render);
+}
+
+void Emulator::render(OutputLevel* output, size_t samples, uint32_t clock, uint32_t rate)
+{
+    auto apply = [&](const Write& write) -> void
+    {
+        return write_register(write);
+    };
+
+    auto write = [&](const OutputLevel& value, const size_t count) -> void
+    {
+        output = std::fill_n(output, count, value);
+    };
+
+    auto render = [&](auto chip) -> void
+    {
+        using Chip = decltype(chip);
+        OutputLevel current;
+        OutputTraits::update<Chip>(current, _state, _sound, _noise, _envelope);
+        ClockTraits::render<Chip>(_state, _sound, _noise, _envelope, current, _queue, apply, write, samples, clock, rate);
+        OutputTraits::update<Chip>(_output, _state, _sound, _noise, _envelope);
+    };
+
+    return ChipTraits::dispatch(_state, render);
+}
+
+auto Emulator::oversample(OutputLevel* output, size_t samples, uint32_t clock, uint32_t rate) -> size_t
+{
+    size_t steps = 0;
+
+    auto apply = [&](const Write& write) -> void
+    {
+        return write_register(write);
+    };
+
+    auto write = [&](const OutputLevel& value, const size_t count) -> void
+    {
+        output = std::fill_n(output, count, value);
+        steps += count;
+    };
+
+    auto oversample = [&](auto chip) -> void
+    {
+        using Chip = decltype(chip);
+        OutputLevel current;
+        OutputTraits::update<Chip>(current, _state, _sound, _noise, _envelope);
+        ClockTraits::oversample<Chip>(_state, _sound, _noise, _envelope, current, _queue, apply, write, samples, clock, rate);
+        OutputTraits::update<Chip>(_output, _state, _sound, _noise, _envelope);
+    };
+
+    ChipTraits::dispatch(_state, oversample);
+
+    return steps;
+}
+
+auto Emulator::transitions(OutputLevel* output, uint32_t* offsets, size_t samples, uint32_t clock, uint32_t rate) -> size_t
+{
+    const uint32_t first = (8 - (_state.ticks & 0x07));
+    uint32_t       steps = 0;
+    size_t         edges = 0;
+
+    auto apply = [&](const Write& write) -> void
+    {
+        return write_register(write);
+    };
+
+    auto emit = [&](const OutputLevel& value, const uint32_t offset) -> void
+    {
+        if(edges != 0) {
+            const OutputLevel& last(output[edges - 1]);
+            if((last.channel0 == value.channel0)
+            && (last.channel1 == value.channel1)
+            && (last.channel2 == value.channel2)) {
+                return;
+            }
+        }
+        output[edges]  = value;
+        offsets[edges] = offset;
+        ++edges;
+    };
+
+    auto write = [&](const OutputLevel& value, const size_t count) -> void
+    {
+        emit(value, (first + (steps * 8)));
+        steps += static_cast<uint32_t>(count);
+    };
+
+    auto transitions = [&](auto chip) -> void
+    {
+        using Chip = decltype(chip);
+        OutputLevel current;
+        OutputTraits::update<Chip>(current, _state, _sound, _noise, _envelope);
+        emit(current, 0);
+        ClockTraits::oversample<Chip>(_state, _sound, _noise, _envelope, current, _queue, apply, write, samples, clock, rate);
+        OutputTraits::update<Chip>(_output, _state, _sound, _noise, _envelope);
+    };
+
+    ChipTraits::dispatch(_state, transitions);
+
+    return edges;
+}
+
+void Emulator::convert(const OutputLevel* input, Output* output, size_t samples) const
+{
+    auto convert = [&](auto chip) -> void
+    {
+        using Chip = decltype(chip);
+        for(size_t index = 0; index < samples; ++index) {
+            const OutputLevel& level(input[index]);
+            Chip::mix(output[index], level.channel0, level.channel1, level.channel2);
+        }
+    };
+
+    return ChipTraits::dispatch(_state, convert);
+}
+
+void Emulator::convert(const OutputLevel* input, OutputInt32* output, size_t samples) const
+{
+    auto convert = [&](auto chip) -> void
+    {
+        using Chip = decltype(chip);
+        for(size_t index = 0; index < samples; ++index) {
+            const OutputLevel& level(input[index]);
+            Chip::mix(output[index], level.channel0, level.channel1, level.channel2);
+        }
+    };
+
+    return ChipTraits::dispatch(_state, convert);
+}
+
+void Emulator::skip(size_t samples, uint32_t clock, uint32_t rate)
+{
+    auto apply = [&](const Write& write) -> void
+    {
+        return write_register(write);
+    };
+
+    auto skip = [&](auto chip) -> void
+    {
+        using Chip = decltype(chip);
+        ClockTraits::skip<Chip>(_state, _sound, _noise, _envelope, _output, _queue, apply, samples, clock, rate);
+    };
+
+    return ChipTraits::dispatch(_state, skip);
+}
+
+auto Emulator::get_horizon() const -> uint32_t
+{
+    return ClockTraits::get_horizon(_state, _sound, _noise, _envelope, _queue);
+}
+
+auto Emulator::get_output(OutputInt32& output) const -> void
+{
+    auto update = [&](auto chip) -> void
+    {
+        using Chip = decltype(chip);
+        OutputTraits::update<Chip>(output, _state, _sound, _noise, _envelope);
+    };
+
+    return ChipTraits::dispatch(_state, update);
+}
+
+auto Emulator::get_output_stage() const -> OutputStage
+{
+    return static_cast<OutputStage>(_state.stage);
+}
+
+auto Emulator::set_output_stage(const OutputStage stage) -> void
+{
+    auto update = [&](auto chip) -> void
+    {
+        using Chip = decltype(chip);
+        OutputTraits::update<Chip>(_output, _state, _sound, _noise, _envelope);
+    };
+
+    switch(stage) {
+        case OutputStage::OUTPUT_STAGE_MIXED:
+            _state.stage = OutputStage::OUTPUT_STAGE_MIXED;
+            break;
+        default:
+            _state.stage = OutputStage::OUTPUT_STAGE_LINEAR;
+            break;
+    }
+    return ChipTraits::dispatch(_state, update);
+}
+
+auto Emulator::push(uint32_t ticks, uint8_t index, uint8_t value) -> void
+{
+    if(index > BasicTraits::ENVELOPE_SHAPE) {
+        throw std::runtime_error("invalid register index");
+    }
+    if(QueueTraits::is_full(_queue)) {
+        throw std::runtime_error("register-write queue is full");
+    }
+    QueueTraits::push(_queue, ticks, index, value);
+}
+
+auto Emulator::save(Snapshot& snapshot) const -> void
+{
+    static_assert(std::is_trivially_copyable<Snapshot>::value, "Snapshot must be trivially copyable");
+
+    static_cast<void>(::memset(&snapshot, 0, sizeof(snapshot)));
+    snapshot.magic    = Snapshot::MAGIC;
+    snapshot.version  = Snapshot::VERSION;
+    snapshot.length   = sizeof(snapshot);
+    SnapshotTraits::copy(snapshot.state,    _state);
+    SnapshotTraits::copy(snapshot.sound[0], _sound[0]);
+    SnapshotTraits::copy(snapshot.sound[1], _sound[1]);
+    SnapshotTraits::copy(snapshot.sound[2], _sound[2]);
+    SnapshotTraits::copy(snapshot.noise[0], _noise[0]);
+    SnapshotTraits::copy(snapshot.envelope, _envelope);
+    SnapshotTraits::copy(snapshot.output,   _output);
+    SnapshotTraits::save(snapshot, _queue);
+}
+
+auto Emulator::restore(const Snapshot& snapshot) -> void
+{
+    if(snapshot.magic != Snapshot::MAGIC) {
+        throw std::runtime_error("invalid snapshot");
+    }
+    if((snapshot.version != Snapshot::VERSION) || (snapshot.length != sizeof(snapshot))) {
+        throw std::runtime_error("unsupported snapshot version");
+    }
+    if(snapshot.state.type != _state.type) {
+        throw std::runtime_error("snapshot chip type mismatch");
+    }
+    if(snapshot.pending > WriteQueue::SIZE) {
+        throw std::runtime_error("invalid snapshot write queue");
+    }
+    SnapshotTraits::copy(_state,    snapshot.state);
+    SnapshotTraits::copy(_sound[0], snapshot.sound[0]);
+    SnapshotTraits::copy(_sound[1], snapshot.sound[1]);
+    SnapshotTraits::copy(_sound[2], snapshot.sound[2]);
+    SnapshotTraits::copy(_noise[0], snapshot.noise[0]);
+    SnapshotTraits::copy(_envelope, snapshot.envelope);
+    SnapshotTraits::copy(_output,   snapshot.output);
+    SnapshotTraits::restore(snapshot, _queue);
 }
 
 auto Emulator::get_index(uint8_t index) -> uint8_t
@@ -580,7 +1801,89 @@ auto Emulator::set_index(uint8_t index) -> uint8_t
     return (_state.index = index);
 }
 
+auto Emulator::load_frame(const uint8_t regs[16], uint16_t dirty_mask) -> void
+{
+    return load_frame(_interface, regs, dirty_mask);
+}
+
+auto Emulator::load_registers(const uint8_t regs[16], uint16_t dirty_mask) -> uint16_t
+{
+    auto&    array   = _state.array;
+    uint16_t changed = 0;
+
+    auto load = [&]() -> void
+    {
+        for(int index = 0; index < 16; ++index) {
+            const uint16_t bit = (1 << index);
+            if((dirty_mask & bit) != 0) {
+                array[index] = (regs[index] & BasicTraits::masks[index]);
+                changed |= bit;
+            }
+        }
+    };
+
+    auto has_changed = [&](const uint16_t mask) -> bool
+    {
+        return ((changed & mask) != 0);
+    };
+
+    auto set_period = [&](uint16_t& period, const int index) -> void
+    {
+        period = (static_cast<uint16_t>(array[index + 1]) << 8) | array[index + 0];
+    };
+
+    auto apply = [&]() -> void
+    {
+        if(has_changed(0x0003)) {
+            set_period(_sound[BasicTraits::SOUND0].period, BasicTraits::CHANNEL_A_FINE_TUNE);
+        }
+        if(has_changed(0x000c)) {
+            set_period(_sound[BasicTraits::SOUND1].period, BasicTraits::CHANNEL_B_FINE_TUNE);
+        }
+        if(has_changed(0x0030)) {
+            set_period(_sound[BasicTraits::SOUND2].period, BasicTraits::CHANNEL_C_FINE_TUNE);
+        }
+        if(has_changed(0x0040)) {
+            static_cast<void>(NoiseTraits::set_fine_tune(_noise[BasicTraits::NOISE0], array[BasicTraits::NOISE_PERIOD]));
+        }
+        if(has_changed(0x0080)) {
+            static_cast<void>(StateTraits::set_mixer_and_io_control(_state, array[BasicTraits::MIXER_AND_IO_CONTROL]));
+        }
+        if(has_changed(0x0100)) {
+            static_cast<void>(SoundTraits::set_amplitude(_sound[BasicTraits::SOUND0], array[BasicTraits::CHANNEL_A_AMPLITUDE]));
+        }
+        if(has_changed(0x0200)) {
+            static_cast<void>(SoundTraits::set_amplitude(_sound[BasicTraits::SOUND1], array[BasicTraits::CHANNEL_B_AMPLITUDE]));
+        }
+        if(has_changed(0x0400)) {
+            static_cast<void>(SoundTraits::set_amplitude(_sound[BasicTraits::SOUND2], array[BasicTraits::CHANNEL_C_AMPLITUDE]));
+        }
+        if(has_changed(0x1800)) {
+            set_period(_envelope.period, BasicTraits::ENVELOPE_FINE_TUNE);
+        }
+        if(has_changed(0x2000)) {
+            static_cast<void>(EnvelopeTraits::set_shape(_envelope, array[BasicTraits::ENVELOPE_SHAPE]));
+        }
+    };
+
+    auto load_registers = [&]() -> uint16_t
+    {
+        load();
+        if(changed != 0) {
+            apply();
+        }
+        return changed;
+    };
+
+    return load_registers();
+}
+
 auto Emulator::get_value(uint8_t value) -> uint8_t
+{
+    return get_value(_interface, value);
+}
+
+auto Emulator::get_register(uint8_t value) -> uint8_t
 {
     const auto index = _state.index;
     auto&      array = _state.array[index & 0x0f];
@@ -628,12 +1931,6 @@ auto Emulator::get_value(uint8_t value) -> uint8_t
         case BasicTraits::ENVELOPE_SHAPE:
             value = EnvelopeTraits::get_shape(_envelope, (array &= 0x0f));
             break;
-        case BasicTraits::IO_PORT_A:
-            value = StateTraits::get_port0(_state, *this, _interface, (array &= 0xff));
-            break;
-        case BasicTraits::IO_PORT_B:
-            value = StateTraits::get_port1(_state, *this, _interface, (array &= 0xff));
-            break;
         default:
             break;
     }
@@ -641,6 +1938,19 @@ auto Emulator::get_value(uint8_t value) -> uint8_t
 }
 
 auto Emulator::set_value(uint8_t value) -> uint8_t
+{
+    return set_value(_interface, value);
+}
+
+auto Emulator::write_register(const Write& write) -> void
+{
+    const uint8_t saved = _state.index;
+    _state.index = write.index;
+    static_cast<void>(set_register(write.value));
+    _state.index = saved;
+}
+
+auto Emulator::set_register(uint8_t value) -> uint8_t
 {
     const auto index = _state.index;
     auto&      array = _state.array[index & 0x0f];
@@ -688,12 +1998,6 @@ auto Emulator::set_value(uint8_t value) -> uint8_t
         case BasicTraits::ENVELOPE_SHAPE:
             array = EnvelopeTraits::set_shape(_envelope, (value &= 0x0f));
             break;
-        case BasicTraits::IO_PORT_A:
-            array = StateTraits::set_port0(_state, *this, _interface, (value &= 0xff));
-            break;
-        case BasicTraits::IO_PORT_B:
-            array = StateTraits::set_port1(_state, *this, _interface, (value &= 0xff));
-            break;
         default:
             break;
     }
@@ -24,6 +24,7 @@
 namespace aym {
 
 struct State;
+struct Snapshot;
 class  Emulator;
 class  Interface;
 
@@ -47,6 +48,40 @@ enum ChipType
 
 }
 
+// ---------------------------------------------------------------------------
+// aym::OutputStage
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+enum OutputStage
+{
+    OUTPUT_STAGE_INVALID = -1,
+    OUTPUT_STAGE_DEFAULT =  0,
+    OUTPUT_STAGE_LINEAR  =  1,
+    OUTPUT_STAGE_MIXED   =  2,
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::Synthesis
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+enum Synthesis
+{
+    SYNTHESIS_INVALID = -1,
+    SYNTHESIS_DEFAULT =  0,
+    SYNTHESIS_HOLD    =  1,
+    SYNTHESIS_FIR     =  2,
+    SYNTHESIS_BLEP    =  3,
+    SYNTHESIS_AREA    =  4,
+};
+
+}
+
 // ---------------------------------------------------------------------------
 // aym::State
 // ---------------------------------------------------------------------------
@@ -56,13 +91,14 @@ namespace aym {
 struct State
 {
     uint8_t  type;
+    uint8_t  stage;
     uint32_t ticks;
+    uint32_t remainder;
     uint8_t  index;
     uint8_t  array[16];
     uint8_t  has_sound[3];
     uint8_t  has_noise[3];
     uint8_t  dir_port[2];
-    float    dac[32];
 };
 
 }
@@ -110,23 +146,79 @@ struct Envelope
     uint16_t counter;
     uint16_t period;
     uint8_t  shape;
-    uint8_t  phase;
-    uint8_t  amplitude;
+    uint8_t  position;
 };
 
 }
 
 // ---------------------------------------------------------------------------
-// aym::Output
+// aym::BasicOutput<T>
 // ---------------------------------------------------------------------------
 
 namespace aym {
 
-struct Output
+template <typename T>
+struct BasicOutput
 {
-    float channel0;
-    float channel1;
-    float channel2;
+    T channel0;
+    T channel1;
+    T channel2;
+};
+
+using OutputLevel = BasicOutput<uint8_t>;
+using OutputInt32 = BasicOutput<int32_t>;
+using OutputFlt32 = BasicOutput<float>;
+using Output      = OutputFlt32;
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::WriteQueue
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+struct Write
+{
+    uint32_t ticks;
+    uint8_t  index;
+    uint8_t  value;
+};
+
+struct WriteQueue
+{
+    static constexpr uint32_t SIZE = 2048;
+
+    uint32_t head;
+    uint32_t tail;
+    uint8_t  stale;
+    Write    writes[SIZE];
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::Snapshot
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+struct Snapshot
+{
+    static constexpr uint32_t MAGIC   = 0x534d5941; /* "AYMS" */
+    static constexpr uint32_t VERSION = 3;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t length;
+    State    state;
+    Sound    sound[3];
+    Noise    noise[1];
+    Envelope envelope;
+    Output   output;
+    uint32_t stale;
+    uint32_t pending;
+    Write    writes[WriteQueue::SIZE];
 };
 
 }
@@ -156,6 +248,41 @@ public: // public interface
 
     auto clock() -> void;
 
+    auto advance(uint32_t ticks) -> void;
+
+    auto render(Output* output, size_t samples, uint32_t clock, uint32_t rate) -> void;
+
+    auto render(OutputInt32* output, size_t samples, uint32_t clock, uint32_t rate) -> void;
+
+    auto render(float* channel0, float* channel1, float* channel2, size_t samples, uint32_t clock, uint32_t rate) -> void;
+
+    auto render(int16_t* channel0, int16_t* channel1, int16_t* channel2, size_t samples, uint32_t clock, uint32_t rate) -> void;
+
+    auto render(OutputLevel* output, size_t samples, uint32_t clock, uint32_t rate) -> void;
+
+    auto oversample(OutputLevel* output, size_t samples, uint32_t clock, uint32_t rate) -> size_t;
+
+    auto transitions(OutputLevel* output, uint32_t* offsets, size_t samples, uint32_t clock, uint32_t rate) -> size_t;
+
+    auto convert(const OutputLevel* input, Output* output, size_t samples) const -> void;
+
+    auto convert(const OutputLevel* input, OutputInt32* output, size_t samples) const -> void;
+
+    auto skip(size_t samples, uint32_t clock, uint32_t rate) -> void;
+
+    auto get_horizon() const -> uint32_t;
+
+    auto get_output_stage() const -> OutputStage;
+
+    auto set_output_stage(const OutputStage stage) -> void;
+
+    auto push(uint32_t ticks, uint8_t index, uint8_t value) -> void;
+
+    auto get_pending() const -> size_t
+    {
+        return (_queue.tail - _queue.head);
+    }
+
     auto get_index(uint8_t index) -> uint8_t;
 
     auto set_index(uint8_t index) -> uint8_t;
@@ -164,6 +291,77 @@ public: // public interface
 
     auto set_value(uint8_t value) -> uint8_t;
 
+    auto load_frame(const uint8_t regs[16], uint16_t dirty_mask) -> void;
+
+    auto save(Snapshot& snapshot) const -> void;
+
+    auto restore(const Snapshot& snapshot) -> void;
+
+    template <typename Ports>
+    auto get_value(Ports& ports, uint8_t value) -> uint8_t
+    {
+        const auto index = _state.index;
+        auto&      array = _state.array[index & 0x0f];
+
+        switch(index) {
+            case 0x0e:
+                value = (array &= 0xff);
+                if(_state.dir_port[0] == 0) {
+                    value = ports.aym_port_a_rd(*this, value);
+                }
+                break;
+            case 0x0f:
+                value = (array &= 0xff);
+                if(_state.dir_port[1] == 0) {
+                    value = ports.aym_port_b_rd(*this, value);
+                }
+                break;
+            default:
+                value = get_register(value);
+                break;
+        }
+        return value;
+    }
+
+    template <typename Ports>
+    auto set_value(Ports& ports, uint8_t value) -> uint8_t
+    {
+        const auto index = _state.index;
+        auto&      array = _state.array[index & 0x0f];
+
+        switch(index) {
+            case 0x0e:
+                array = (value &= 0xff);
+                if(_state.dir_port[0] != 0) {
+                    array = ports.aym_port_a_wr(*this, value);
+                }
+                break;
+            case 0x0f:
+                array = (value &= 0xff);
+                if(_state.dir_port[1] != 0) {
+                    array = ports.aym_port_b_wr(*this, value);
+                }
+                break;
+            default:
+                value = set_register(value);
+                break;
+        }
+        return value;
+    }
+
+    template <typename Ports>
+    auto load_frame(Ports& ports, const uint8_t regs[16], uint16_t dirty_mask) -> void
+    {
+        const uint16_t changed = load_registers(regs, dirty_mask);
+
+        if((changed & 0x4000) != 0) {
+            write_port(ports, 0x0e);
+        }
+        if((changed & 0x8000) != 0) {
+            write_port(ports, 0x0f);
+        }
+    }
+
     auto operator->() -> State*
     {
         return &_state;
@@ -174,6 +372,26 @@ public: // public interface
         return _output;
     }
 
+    auto get_output(OutputInt32& output) const -> void;
+
+protected: // protected interface
+    auto get_register(uint8_t value) -> uint8_t;
+
+    auto set_register(uint8_t value) -> uint8_t;
+
+    auto write_register(const Write& write) -> void;
+
+    auto load_registers(const uint8_t regs[16], uint16_t dirty_mask) -> uint16_t;
+
+    template <typename Ports>
+    auto write_port(Ports& ports, uint8_t index) -> void
+    {
+        const uint8_t saved = _state.index;
+        _state.index = index;
+        static_cast<void>(set_value(ports, _state.array[index]));
+        _state.index = saved;
+    }
+
 protected: // protected data
     Interface& _interface;
     State      _state;
@@ -181,6 +399,7 @@ protected: // protected data
     Noise      _noise[1];
     Envelope   _envelope;
     Output     _output;
+    WriteQueue _queue;
 };
 
 }
@@ -0,0 +1,151 @@
+/*
+ * aym-filter.cc - Copyright (c) 2023-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstdarg>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include "aym-filter.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::FilterTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct FilterTraits
+{
+    using Biquad        = aym::Biquad;
+    using FilterChain   = aym::FilterChain;
+    using FilterProfile = aym::FilterProfile;
+
+    struct Profile
+    {
+        double highpass;
+        double lowpass;
+    };
+
+    static constexpr float   dc_pole     = 0.999f;
+    static constexpr int32_t dc_pole_s16 = 32735; /* 0.999 in Q15 */
+    static constexpr double  resonance   = 0.70710678118654752440;
+
+    static inline auto get_profile(const FilterProfile profile) -> Profile
+    {
+        switch(profile) {
+            case FilterProfile::FILTER_PROFILE_SPECTRUM:
+                return Profile { 20.0, 8000.0 };
+            case FilterProfile::FILTER_PROFILE_CPC:
+                return Profile { 16.0, 10000.0 };
+            case FilterProfile::FILTER_PROFILE_ATARI:
+                return Profile { 25.0, 6500.0 };
+            default:
+                break;
+        }
+        return Profile { 0.0, 0.0 };
+    }
+
+    static inline auto is_stable(const Biquad& biquad) -> bool
+    {
+        return (std::fabs(biquad.a2) < 1.0f) && (std::fabs(biquad.a1) < (1.0f + biquad.a2));
+    }
+
+    static inline auto add_biquad(FilterChain& chain, const double frequency, const double samplerate, const bool highpass) -> void
+    {
+        if((frequency <= 0.0) || (frequency >= (0.45 * samplerate))) {
+            return;
+        }
+        const double omega = (2.0 * M_PI * frequency) / samplerate;
+        const double cosw  = std::cos(omega);
+        const double alpha = std::sin(omega) / (2.0 * resonance);
+        const double a0    = (1.0 + alpha);
+        const double b1    = (highpass ? -(1.0 + cosw) : (1.0 - cosw));
+        const double b0    = (highpass ? -b1 : b1) * 0.5;
+        const Biquad biquad {
+            static_cast<float>(b0 / a0),
+            static_cast<float>(b1 / a0),
+            static_cast<float>(b0 / a0),
+            static_cast<float>((-2.0 * cosw) / a0),
+            static_cast<float>((1.0 - alpha) / a0),
+        };
+        if(is_stable(biquad) == false) {
+            throw std::runtime_error("unstable filter");
+        }
+        if(chain.biquads < FilterChain::MAX_BIQUADS) {
+            chain.biquad[chain.biquads++] = biquad;
+        }
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::Filter
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+Filter::Filter(const Kernels& kernels)
+    : _kernels(kernels)
+    , _chain()
+    , _state()
+{
+    configure(FilterProfile::FILTER_PROFILE_DEFAULT, 0);
+}
+
+auto Filter::reset() -> void
+{
+    _state = FilterState();
+}
+
+auto Filter::configure(FilterProfile profile, uint32_t samplerate) -> void
+{
+    const auto settings = FilterTraits::get_profile(profile);
+
+    _chain = FilterChain();
+    _chain.dc_pole     = FilterTraits::dc_pole;
+    _chain.dc_pole_s16 = FilterTraits::dc_pole_s16;
+    FilterTraits::add_biquad(_chain, settings.highpass, samplerate, true);
+    FilterTraits::add_biquad(_chain, settings.lowpass, samplerate, false);
+    reset();
+}
+
+auto Filter::process(float* const* samples, uint32_t channels, size_t count) -> void
+{
+    return _kernels.filter_f32(samples, channels, count, _chain, _state);
+}
+
+auto Filter::process(int32_t* const* samples, uint32_t channels, size_t count) -> void
+{
+    return _kernels.filter_s16(samples, channels, count, _chain, _state);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
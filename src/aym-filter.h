@@ -0,0 +1,82 @@
+/*
+ * aym-filter.h - Copyright (c) 2023-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __AYM_Filter_h__
+#define __AYM_Filter_h__
+
+#include "aym-emulator.h"
+#include "aym-kernels.h"
+
+// ---------------------------------------------------------------------------
+// aym::FilterProfile
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+enum FilterProfile
+{
+    FILTER_PROFILE_INVALID  = -1,
+    FILTER_PROFILE_DEFAULT  =  0,
+    FILTER_PROFILE_FLAT     =  1,
+    FILTER_PROFILE_SPECTRUM =  2,
+    FILTER_PROFILE_CPC      =  3,
+    FILTER_PROFILE_ATARI    =  4,
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::Filter
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+class Filter
+{
+public: // public interface
+    Filter(const Kernels& kernels);
+
+    Filter(Filter&&) = delete;
+
+    Filter(const Filter&) = delete;
+
+    Filter& operator=(Filter&&) = delete;
+
+    Filter& operator=(const Filter&) = delete;
+
+    virtual ~Filter() = default;
+
+    auto reset() -> void;
+
+    auto configure(FilterProfile profile, uint32_t samplerate) -> void;
+
+    auto process(float* const* samples, uint32_t channels, size_t count) -> void;
+
+    auto process(int32_t* const* samples, uint32_t channels, size_t count) -> void;
+
+protected: // protected data
+    const Kernels& _kernels;
+    FilterChain    _chain;
+    FilterState    _state;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __AYM_Filter_h__ */
@@ -0,0 +1,542 @@
+/*
+ * aym-kernels.cc - Copyright (c) 2023-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstdarg>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include "aym-kernels.h"
+
+// ---------------------------------------------------------------------------
+// some useful macros
+// ---------------------------------------------------------------------------
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AYM_KERNELS_X86 1
+#define AYM_TARGET(isa) __attribute__((target(isa)))
+#else
+#define AYM_KERNELS_X86 0
+#define AYM_TARGET(isa)
+#endif
+
+#define AYM_INLINE inline __attribute__((always_inline))
+
+// ---------------------------------------------------------------------------
+// <anonymous>::BasicKernels
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct BasicKernels
+{
+    using Output      = aym::Output;
+    using OutputInt32 = aym::OutputInt32;
+    using MixMatrix   = aym::MixMatrix;
+    using Biquad      = aym::Biquad;
+    using FilterChain = aym::FilterChain;
+    using FilterState = aym::FilterState;
+
+    typedef float Lanes __attribute__((vector_size(4 * sizeof(float))));
+
+    template <uint32_t C>
+    static AYM_INLINE auto mix_row_f32(const Output* psg_output, const float (&gains)[MixMatrix::MAX_INPUTS], const float norm) -> float
+    {
+        float value = 0.0f;
+
+        for(uint32_t chip = 0; chip < C; ++chip) {
+            value += (psg_output[chip].channel0 * gains[(chip * 3) + 0])
+                   + (psg_output[chip].channel1 * gains[(chip * 3) + 1])
+                   + (psg_output[chip].channel2 * gains[(chip * 3) + 2])
+                   ;
+        }
+        return (value / norm);
+    }
+
+    template <uint32_t C>
+    static AYM_INLINE auto mix_mono_chips_f32(const Output* __restrict input, float* __restrict mono, const size_t count, const MixMatrix& matrix) -> void
+    {
+        const MixMatrix local(matrix);
+
+        for(size_t index = 0; index < count; ++index) {
+            const Output* psg_output(input + (index * C));
+            mono[index] = mix_row_f32<C>(psg_output, local.gains_f32[0], local.norms_f32[0]);
+        }
+    }
+
+    template <uint32_t C>
+    static AYM_INLINE auto mix_stereo_chips_f32(const Output* __restrict input, float* __restrict left, float* __restrict right, const size_t count, const MixMatrix& matrix) -> void
+    {
+        const MixMatrix local(matrix);
+
+        for(size_t index = 0; index < count; ++index) {
+            const Output* psg_output(input + (index * C));
+            left[index]  = mix_row_f32<C>(psg_output, local.gains_f32[0], local.norms_f32[0]);
+            right[index] = mix_row_f32<C>(psg_output, local.gains_f32[1], local.norms_f32[1]);
+        }
+    }
+
+    template <uint32_t C>
+    static AYM_INLINE auto mix_quad_chips_f32(const Output* __restrict input, float* __restrict front_left, float* __restrict front_right, float* __restrict back_left, float* __restrict back_right, const size_t count, const MixMatrix& matrix) -> void
+    {
+        const MixMatrix local(matrix);
+
+        for(size_t index = 0; index < count; ++index) {
+            const Output* psg_output(input + (index * C));
+            front_left[index]  = mix_row_f32<C>(psg_output, local.gains_f32[0], local.norms_f32[0]);
+            front_right[index] = mix_row_f32<C>(psg_output, local.gains_f32[1], local.norms_f32[1]);
+            back_left[index]   = mix_row_f32<C>(psg_output, local.gains_f32[2], local.norms_f32[2]);
+            back_right[index]  = mix_row_f32<C>(psg_output, local.gains_f32[3], local.norms_f32[3]);
+        }
+    }
+
+    static AYM_INLINE auto mix_mono_f32(const Output* input, float* mono, const size_t count, const MixMatrix& matrix) -> void
+    {
+        switch(matrix.chips) {
+            case 1:
+                return mix_mono_chips_f32<1>(input, mono, count, matrix);
+            case 2:
+                return mix_mono_chips_f32<2>(input, mono, count, matrix);
+            case 3:
+                return mix_mono_chips_f32<3>(input, mono, count, matrix);
+            case 4:
+                return mix_mono_chips_f32<4>(input, mono, count, matrix);
+            default:
+                break;
+        }
+    }
+
+    static AYM_INLINE auto mix_stereo_f32(const Output* input, float* left, float* right, const size_t count, const MixMatrix& matrix) -> void
+    {
+        switch(matrix.chips) {
+            case 1:
+                return mix_stereo_chips_f32<1>(input, left, right, count, matrix);
+            case 2:
+                return mix_stereo_chips_f32<2>(input, left, right, count, matrix);
+            case 3:
+                return mix_stereo_chips_f32<3>(input, left, right, count, matrix);
+            case 4:
+                return mix_stereo_chips_f32<4>(input, left, right, count, matrix);
+            default:
+                break;
+        }
+    }
+
+    static AYM_INLINE auto mix_quad_f32(const Output* input, float* front_left, float* front_right, float* back_left, float* back_right, const size_t count, const MixMatrix& matrix) -> void
+    {
+        switch(matrix.chips) {
+            case 1:
+                return mix_quad_chips_f32<1>(input, front_left, front_right, back_left, back_right, count, matrix);
+            case 2:
+                return mix_quad_chips_f32<2>(input, front_left, front_right, back_left, back_right, count, matrix);
+            case 3:
+                return mix_quad_chips_f32<3>(input, front_left, front_right, back_left, back_right, count, matrix);
+            case 4:
+                return mix_quad_chips_f32<4>(input, front_left, front_right, back_left, back_right, count, matrix);
+            default:
+                break;
+        }
+    }
+
+    template <uint32_t N>
+    static AYM_INLINE auto filter_lanes_f32(float* const* __restrict samples, const size_t count, const FilterChain& chain, FilterState& state) -> void
+    {
+        const FilterChain local(chain);
+        Lanes             dc_input;
+        Lanes             dc_output;
+        Lanes             biquad[FilterChain::MAX_BIQUADS][2];
+
+        static_cast<void>(::memcpy(&dc_input, state.dc_input, sizeof(dc_input)));
+        static_cast<void>(::memcpy(&dc_output, state.dc_output, sizeof(dc_output)));
+        static_cast<void>(::memcpy(&biquad, state.biquad, sizeof(biquad)));
+        for(size_t index = 0; index < count; ++index) {
+            Lanes value = {};
+            for(uint32_t lane = 0; lane < N; ++lane) {
+                value[lane] = samples[lane][index];
+            }
+            dc_output = (value - dc_input) + (local.dc_pole * dc_output);
+            dc_input  = value;
+            value     = dc_output;
+            for(uint32_t stage = 0; stage < local.biquads; ++stage) {
+                const Biquad& coefs(local.biquad[stage]);
+                const Lanes   result = (value * coefs.b0) + biquad[stage][0];
+                biquad[stage][0] = ((value * coefs.b1) - (result * coefs.a1)) + biquad[stage][1];
+                biquad[stage][1] = ((value * coefs.b2) - (result * coefs.a2));
+                value = result;
+            }
+            for(uint32_t lane = 0; lane < N; ++lane) {
+                samples[lane][index] = value[lane];
+            }
+        }
+        static_cast<void>(::memcpy(state.dc_input, &dc_input, sizeof(dc_input)));
+        static_cast<void>(::memcpy(state.dc_output, &dc_output, sizeof(dc_output)));
+        static_cast<void>(::memcpy(state.biquad, &biquad, sizeof(biquad)));
+    }
+
+    static AYM_INLINE auto filter_f32(float* const* samples, const uint32_t channels, const size_t count, const FilterChain& chain, FilterState& state) -> void
+    {
+        switch(channels) {
+            case 1:
+                return filter_lanes_f32<1>(samples, count, chain, state);
+            case 2:
+                return filter_lanes_f32<2>(samples, count, chain, state);
+            case 3:
+                return filter_lanes_f32<3>(samples, count, chain, state);
+            case 4:
+                return filter_lanes_f32<4>(samples, count, chain, state);
+            default:
+                break;
+        }
+    }
+
+    static AYM_INLINE auto finish_f32(float* __restrict samples, const size_t count, const float volume) -> void
+    {
+        for(size_t index = 0; index < count; ++index) {
+            float value = (samples[index] * volume);
+            value = (value < -1.0f ? -1.0f : value);
+            value = (value > +1.0f ? +1.0f : value);
+            samples[index] = value;
+        }
+    }
+
+    template <uint32_t C>
+    static AYM_INLINE auto mix_row_s16(const OutputInt32* psg_output, const int32_t (&gains)[MixMatrix::MAX_INPUTS], const int32_t norm) -> int32_t
+    {
+        int32_t value = 0;
+
+        for(uint32_t chip = 0; chip < C; ++chip) {
+            value += (psg_output[chip].channel0 * gains[(chip * 3) + 0])
+                   + (psg_output[chip].channel1 * gains[(chip * 3) + 1])
+                   + (psg_output[chip].channel2 * gains[(chip * 3) + 2])
+                   ;
+        }
+        return (value / norm);
+    }
+
+    template <uint32_t C>
+    static AYM_INLINE auto mix_mono_chips_s16(const OutputInt32* __restrict input, int32_t* __restrict mono, const size_t count, const MixMatrix& matrix) -> void
+    {
+        const MixMatrix local(matrix);
+
+        for(size_t index = 0; index < count; ++index) {
+            const OutputInt32* psg_output(input + (index * C));
+            mono[index] = mix_row_s16<C>(psg_output, local.gains_s16[0], local.norms_s16[0]);
+        }
+    }
+
+    template <uint32_t C>
+    static AYM_INLINE auto mix_stereo_chips_s16(const OutputInt32* __restrict input, int32_t* __restrict left, int32_t* __restrict right, const size_t count, const MixMatrix& matrix) -> void
+    {
+        const MixMatrix local(matrix);
+
+        for(size_t index = 0; index < count; ++index) {
+            const OutputInt32* psg_output(input + (index * C));
+            left[index]  = mix_row_s16<C>(psg_output, local.gains_s16[0], local.norms_s16[0]);
+            right[index] = mix_row_s16<C>(psg_output, local.gains_s16[1], local.norms_s16[1]);
+        }
+    }
+
+    template <uint32_t C>
+    static AYM_INLINE auto mix_quad_chips_s16(const OutputInt32* __restrict input, int32_t* __restrict front_left, int32_t* __restrict front_right, int32_t* __restrict back_left, int32_t* __restrict back_right, const size_t count, const MixMatrix& matrix) -> void
+    {
+        const MixMatrix local(matrix);
+
+        for(size_t index = 0; index < count; ++index) {
+            const OutputInt32* psg_output(input + (index * C));
+            front_left[index]  = mix_row_s16<C>(psg_output, local.gains_s16[0], local.norms_s16[0]);
+            front_right[index] = mix_row_s16<C>(psg_output, local.gains_s16[1], local.norms_s16[1]);
+            back_left[index]   = mix_row_s16<C>(psg_output, local.gains_s16[2], local.norms_s16[2]);
+            back_right[index]  = mix_row_s16<C>(psg_output, local.gains_s16[3], local.norms_s16[3]);
+        }
+    }
+
+    static AYM_INLINE auto mix_mono_s16(const OutputInt32* input, int32_t* mono, const size_t count, const MixMatrix& matrix) -> void
+    {
+        switch(matrix.chips) {
+            case 1:
+                return mix_mono_chips_s16<1>(input, mono, count, matrix);
+            case 2:
+                return mix_mono_chips_s16<2>(input, mono, count, matrix);
+            case 3:
+                return mix_mono_chips_s16<3>(input, mono, count, matrix);
+            case 4:
+                return mix_mono_chips_s16<4>(input, mono, count, matrix);
+            default:
+                break;
+        }
+    }
+
+    static AYM_INLINE auto mix_stereo_s16(const OutputInt32* input, int32_t* left, int32_t* right, const size_t count, const MixMatrix& matrix) -> void
+    {
+        switch(matrix.chips) {
+            case 1:
+                return mix_stereo_chips_s16<1>(input, left, right, count, matrix);
+            case 2:
+                return mix_stereo_chips_s16<2>(input, left, right, count, matrix);
+            case 3:
+                return mix_stereo_chips_s16<3>(input, left, right, count, matrix);
+            case 4:
+                return mix_stereo_chips_s16<4>(input, left, right, count, matrix);
+            default:
+                break;
+        }
+    }
+
+    static AYM_INLINE auto mix_quad_s16(const OutputInt32* input, int32_t* front_left, int32_t* front_right, int32_t* back_left, int32_t* back_right, const size_t count, const MixMatrix& matrix) -> void
+    {
+        switch(matrix.chips) {
+            case 1:
+                return mix_quad_chips_s16<1>(input, front_left, front_right, back_left, back_right, count, matrix);
+            case 2:
+                return mix_quad_chips_s16<2>(input, front_left, front_right, back_left, back_right, count, matrix);
+            case 3:
+                return mix_quad_chips_s16<3>(input, front_left, front_right, back_left, back_right, count, matrix);
+            case 4:
+                return mix_quad_chips_s16<4>(input, front_left, front_right, back_left, back_right, count, matrix);
+            default:
+                break;
+        }
+    }
+
+    template <uint32_t N>
+    static AYM_INLINE auto filter_lanes_s16(int32_t* const* __restrict samples, const size_t count, const FilterChain& chain, FilterState& state) -> void
+    {
+        const FilterChain local(chain);
+        const int64_t     attenuation = local.dc_pole_s16;
+        int32_t           last_input[4];
+        int32_t           last_output[4];
+        Lanes             biquad[FilterChain::MAX_BIQUADS][2];
+
+        static_cast<void>(::memcpy(last_input, state.dc_input_s16, sizeof(last_input)));
+        static_cast<void>(::memcpy(last_output, state.dc_output_s16, sizeof(last_output)));
+        static_cast<void>(::memcpy(&biquad, state.biquad_s16, sizeof(biquad)));
+        for(size_t index = 0; index < count; ++index) {
+            Lanes value = {};
+            for(uint32_t lane = 0; lane < N; ++lane) {
+                const int32_t sample = samples[lane][index];
+                last_output[lane] = ((sample - last_input[lane]) * 256) + static_cast<int32_t>(((attenuation * last_output[lane]) + 16384) >> 15);
+                last_input[lane]  = sample;
+                samples[lane][index] = (last_output[lane] >> 8);
+            }
+            if(local.biquads == 0) {
+                continue;
+            }
+            for(uint32_t lane = 0; lane < N; ++lane) {
+                value[lane] = static_cast<float>(samples[lane][index]);
+            }
+            for(uint32_t stage = 0; stage < local.biquads; ++stage) {
+                const Biquad& coefs(local.biquad[stage]);
+                const Lanes   result = (value * coefs.b0) + biquad[stage][0];
+                biquad[stage][0] = ((value * coefs.b1) - (result * coefs.a1)) + biquad[stage][1];
+                biquad[stage][1] = ((value * coefs.b2) - (result * coefs.a2));
+                value = result;
+            }
+            for(uint32_t lane = 0; lane < N; ++lane) {
+                samples[lane][index] = static_cast<int32_t>(std::lrint(value[lane]));
+            }
+        }
+        static_cast<void>(::memcpy(state.dc_input_s16, last_input, sizeof(last_input)));
+        static_cast<void>(::memcpy(state.dc_output_s16, last_output, sizeof(last_output)));
+        static_cast<void>(::memcpy(state.biquad_s16, &biquad, sizeof(biquad)));
+    }
+
+    static AYM_INLINE auto filter_s16(int32_t* const* samples, const uint32_t channels, const size_t count, const FilterChain& chain, FilterState& state) -> void
+    {
+        switch(channels) {
+            case 1:
+                return filter_lanes_s16<1>(samples, count, chain, state);
+            case 2:
+                return filter_lanes_s16<2>(samples, count, chain, state);
+            case 3:
+                return filter_lanes_s16<3>(samples, count, chain, state);
+            case 4:
+                return filter_lanes_s16<4>(samples, count, chain, state);
+            default:
+                break;
+        }
+    }
+
+    static AYM_INLINE auto finish_s16(const int32_t* __restrict input, int16_t* __restrict output, const size_t count, const float volume) -> void
+    {
+        const int64_t gain = static_cast<int64_t>(volume * 32768.0f);
+
+        for(size_t index = 0; index < count; ++index) {
+            int32_t value = static_cast<int32_t>((input[index] * gain) >> 15);
+            value = (value < -32768 ? -32768 : value);
+            value = (value > +32767 ? +32767 : value);
+            output[index] = static_cast<int16_t>(value);
+        }
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::XxxKernels
+// ---------------------------------------------------------------------------
+
+#define AYM_DEFINE_KERNELS(kernels, name, attributes)                                                                               \
+namespace {                                                                                                                         \
+                                                                                                                                    \
+struct kernels final                                                                                                                \
+{                                                                                                                                   \
+    using Output      = aym::Output;                                                                                                \
+    using OutputInt32 = aym::OutputInt32;                                                                                           \
+    using MixMatrix   = aym::MixMatrix;                                                                                             \
+    using FilterChain = aym::FilterChain;                                                                                           \
+    using FilterState = aym::FilterState;                                                                                           \
+                                                                                                                                    \
+    attributes static auto mix_mono_f32(const Output* input, float* mono, size_t count, const MixMatrix& matrix) -> void            \
+    {                                                                                                                               \
+        return BasicKernels::mix_mono_f32(input, mono, count, matrix);                                                              \
+    }                                                                                                                               \
+                                                                                                                                    \
+    attributes static auto mix_stereo_f32(const Output* input, float* left, float* right, size_t count,                             \
+                                          const MixMatrix& matrix) -> void                                                          \
+    {                                                                                                                               \
+        return BasicKernels::mix_stereo_f32(input, left, right, count, matrix);                                                     \
+    }                                                                                                                               \
+                                                                                                                                    \
+    attributes static auto mix_quad_f32(const Output* input, float* front_left, float* front_right, float* back_left,               \
+                                        float* back_right, size_t count, const MixMatrix& matrix) -> void                           \
+    {                                                                                                                               \
+        return BasicKernels::mix_quad_f32(input, front_left, front_right, back_left, back_right, count, matrix);                    \
+    }                                                                                                                               \
+                                                                                                                                    \
+    attributes static auto filter_f32(float* const* samples, uint32_t channels, size_t count,                                       \
+                                      const FilterChain& chain, FilterState& state) -> void                                         \
+    {                                                                                                                               \
+        return BasicKernels::filter_f32(samples, channels, count, chain, state);                                                    \
+    }                                                                                                                               \
+                                                                                                                                    \
+    attributes static auto finish_f32(float* samples, size_t count, float volume) -> void                                           \
+    {                                                                                                                               \
+        return BasicKernels::finish_f32(samples, count, volume);                                                                    \
+    }                                                                                                                               \
+                                                                                                                                    \
+    attributes static auto mix_mono_s16(const OutputInt32* input, int32_t* mono, size_t count, const MixMatrix& matrix) -> void     \
+    {                                                                                                                               \
+        return BasicKernels::mix_mono_s16(input, mono, count, matrix);                                                              \
+    }                                                                                                                               \
+                                                                                                                                    \
+    attributes static auto mix_stereo_s16(const OutputInt32* input, int32_t* left, int32_t* right, size_t count,                    \
+                                          const MixMatrix& matrix) -> void                                                          \
+    {                                                                                                                               \
+        return BasicKernels::mix_stereo_s16(input, left, right, count, matrix);                                                     \
+    }                                                                                                                               \
+                                                                                                                                    \
+    attributes static auto mix_quad_s16(const OutputInt32* input, int32_t* front_left, int32_t* front_right, int32_t* back_left,    \
+                                        int32_t* back_right, size_t count, const MixMatrix& matrix) -> void                         \
+    {                                                                                                                               \
+        return BasicKernels::mix_quad_s16(input, front_left, front_right, back_left, back_right, count, matrix);                    \
+    }                                                                                                                               \
+                                                                                                                                    \
+    attributes static auto filter_s16(int32_t* const* samples, uint32_t channels, size_t count,                                     \
+                                      const FilterChain& chain, FilterState& state) -> void                                         \
+    {                                                                                                                               \
+        return BasicKernels::filter_s16(samples, channels, count, chain, state);                                                    \
+    }                                                                                                                               \
+                                                                                                                                    \
+    attributes static auto finish_s16(const int32_t* input, int16_t* output, size_t count, float volume) -> void                    \
+    {                                                                                                                               \
+        return BasicKernels::finish_s16(input, output, count, volume);                                                              \
+    }                                                                                                                               \
+                                                                                                                                    \
+    static const aym::Kernels table;                                                                                                \
+};                                                                                                                                  \
+                                                                                                                                    \
+const aym::Kernels kernels::table = {                                                                                               \
+    name,                                                                                                                           \
+    &kernels::mix_mono_f32,                                                                                                         \
+    &kernels::mix_stereo_f32,                                                                                                       \
+    &kernels::mix_quad_f32,                                                                                                         \
+    &kernels::filter_f32,                                                                                                           \
+    &kernels::finish_f32,                                                                                                           \
+    &kernels::mix_mono_s16,                                                                                                         \
+    &kernels::mix_stereo_s16,                                                                                                       \
+    &kernels::mix_quad_s16,                                                                                                         \
+    &kernels::filter_s16,                                                                                                           \
+    &kernels::finish_s16,                                                                                                           \
+};                                                                                                                                  \
+                                                                                                                                    \
+}
+
+AYM_DEFINE_KERNELS(DefaultKernels, "default", )
+#if AYM_KERNELS_X86
+AYM_DEFINE_KERNELS(Avx2Kernels, "avx2", AYM_TARGET("avx2"))
+AYM_DEFINE_KERNELS(Avx512Kernels, "avx512", AYM_TARGET("avx512f,avx512bw"))
+#endif
+
+// ---------------------------------------------------------------------------
+// aym::Kernels
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+auto Kernels::get() -> const Kernels&
+{
+    auto select = []() -> const Kernels&
+    {
+#if AYM_KERNELS_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+            return Avx512Kernels::table;
+        }
+        if(__builtin_cpu_supports("avx2")) {
+            return Avx2Kernels::table;
+        }
+#endif
+        return DefaultKernels::table;
+    };
+
+    static const Kernels& kernels(select());
+
+    return kernels;
+}
+
+auto Kernels::get(const std::string& name) -> const Kernels&
+{
+    if(name == "default") {
+        return DefaultKernels::table;
+    }
+#if AYM_KERNELS_X86
+    __builtin_cpu_init();
+    if((name == "avx2") && __builtin_cpu_supports("avx2")) {
+        return Avx2Kernels::table;
+    }
+    if((name == "avx512") && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return Avx512Kernels::table;
+    }
+#endif
+    throw std::runtime_error("unsupported kernels " + name);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,120 @@
+/*
+ * aym-kernels.h - Copyright (c) 2023-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __AYM_Kernels_h__
+#define __AYM_Kernels_h__
+
+#include "aym-emulator.h"
+
+// ---------------------------------------------------------------------------
+// aym::MixMatrix
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+struct MixMatrix
+{
+    static constexpr uint32_t MAX_CHIPS  = 4;
+    static constexpr uint32_t MAX_INPUTS = (MAX_CHIPS * 3);
+
+    uint32_t chips;
+    float    gains_f32[4][MAX_INPUTS];
+    float    norms_f32[4];
+    int32_t  gains_s16[4][MAX_INPUTS];
+    int32_t  norms_s16[4];
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::FilterChain
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+struct Biquad
+{
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+};
+
+struct FilterChain
+{
+    static constexpr uint32_t MAX_BIQUADS = 2;
+
+    float    dc_pole;
+    int32_t  dc_pole_s16;
+    uint32_t biquads;
+    Biquad   biquad[MAX_BIQUADS];
+};
+
+struct FilterState
+{
+    float   dc_input[4];
+    float   dc_output[4];
+    int32_t dc_input_s16[4];
+    int32_t dc_output_s16[4];
+    float   biquad[FilterChain::MAX_BIQUADS][2][4];
+    float   biquad_s16[FilterChain::MAX_BIQUADS][2][4];
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::Kernels
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+struct Kernels
+{
+    const char* name;
+
+    void (*mix_mono_f32)(const Output* input, float* mono, size_t count, const MixMatrix& matrix);
+
+    void (*mix_stereo_f32)(const Output* input, float* left, float* right, size_t count, const MixMatrix& matrix);
+
+    void (*mix_quad_f32)(const Output* input, float* front_left, float* front_right, float* back_left, float* back_right, size_t count, const MixMatrix& matrix);
+
+    void (*filter_f32)(float* const* samples, uint32_t channels, size_t count, const FilterChain& chain, FilterState& state);
+
+    void (*finish_f32)(float* samples, size_t count, float volume);
+
+    void (*mix_mono_s16)(const OutputInt32* input, int32_t* mono, size_t count, const MixMatrix& matrix);
+
+    void (*mix_stereo_s16)(const OutputInt32* input, int32_t* left, int32_t* right, size_t count, const MixMatrix& matrix);
+
+    void (*mix_quad_s16)(const OutputInt32* input, int32_t* front_left, int32_t* front_right, int32_t* back_left, int32_t* back_right, size_t count, const MixMatrix& matrix);
+
+    void (*filter_s16)(int32_t* const* samples, uint32_t channels, size_t count, const FilterChain& chain, FilterState& state);
+
+    void (*finish_s16)(const int32_t* input, int16_t* output, size_t count, float volume);
+
+    static auto get() -> const Kernels&;
+
+    static auto get(const std::string& name) -> const Kernels&;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __AYM_Kernels_h__ */
@@ -0,0 +1,242 @@
+/*
+ * aym-mixer.cc - Copyright (c) 2023-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstdarg>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include "aym-mixer.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::MixerTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct MixerTraits
+{
+    using Panning = aym::Panning;
+
+    static constexpr float Q8 = 256.0f;
+
+    static inline auto get_panning(const Panning panning, float (&left)[3], float (&right)[3]) -> void
+    {
+        auto set_panning = [&](const float channel0, const float channel1, const float channel2) -> void
+        {
+            left[0]  = channel0;
+            left[1]  = channel1;
+            left[2]  = channel2;
+            right[0] = (1.0f - channel0);
+            right[1] = (1.0f - channel1);
+            right[2] = (1.0f - channel2);
+        };
+
+        auto set_mono = [&]() -> void
+        {
+            left[0]  = right[0] = 1.0f;
+            left[1]  = right[1] = 1.0f;
+            left[2]  = right[2] = 1.0f;
+        };
+
+        switch(panning) {
+            case Panning::PANNING_ACB:
+                set_panning(0.75f, 0.25f, 0.50f);
+                break;
+            case Panning::PANNING_BAC:
+                set_panning(0.50f, 0.75f, 0.25f);
+                break;
+            case Panning::PANNING_MONO:
+                set_mono();
+                break;
+            default:
+                set_panning(0.75f, 0.50f, 0.25f);
+                break;
+        }
+    }
+
+    static inline auto get_norm(const float (&gains)[aym::MixMatrix::MAX_INPUTS], const uint32_t inputs) -> float
+    {
+        float norm = 0.0f;
+
+        for(uint32_t input = 0; input < inputs; ++input) {
+            norm += std::fabs(gains[input]);
+        }
+        return (norm != 0.0f ? norm : 1.0f);
+    }
+
+    static inline auto get_norm(const int32_t (&gains)[aym::MixMatrix::MAX_INPUTS], const uint32_t inputs) -> int32_t
+    {
+        int32_t norm = 0;
+
+        for(uint32_t input = 0; input < inputs; ++input) {
+            norm += std::abs(gains[input]);
+        }
+        return (norm != 0 ? norm : 1);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::Mixer
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+Mixer::Mixer(const Kernels& kernels)
+    : _kernels(kernels)
+    , _outputs(0)
+    , _chips(0)
+    , _matrix()
+{
+    configure(Panning::PANNING_DEFAULT, 2, 1);
+}
+
+auto Mixer::configure(Panning panning, uint32_t outputs, uint32_t chips) -> void
+{
+    float left[3];
+    float right[3];
+
+    auto set_row = [&](const uint32_t row, const float (&gains)[3]) -> void
+    {
+        for(uint32_t chip = 0; chip < MixMatrix::MAX_CHIPS; ++chip) {
+            float* row_gains = &_matrix.gains_f32[row][chip * 3];
+            row_gains[0] = (chip < _chips ? gains[0] : 0.0f);
+            row_gains[1] = (chip < _chips ? gains[1] : 0.0f);
+            row_gains[2] = (chip < _chips ? gains[2] : 0.0f);
+        }
+    };
+
+    auto set_mono = [&]() -> void
+    {
+        const float center[3] = {
+            (left[0] + right[0]),
+            (left[1] + right[1]),
+            (left[2] + right[2]),
+        };
+        for(uint32_t row = 0; row < MAX_OUTPUTS; ++row) {
+            set_row(row, center);
+        }
+    };
+
+    auto set_stereo = [&]() -> void
+    {
+        for(uint32_t row = 0; row < MAX_OUTPUTS; ++row) {
+            set_row(row, ((row & 1) == 0 ? left : right));
+        }
+    };
+
+    auto configure = [&]() -> void
+    {
+        MixerTraits::get_panning(panning, left, right);
+        _outputs = std::min(outputs, MAX_OUTPUTS);
+        _chips   = std::max(1u, std::min(chips, MixMatrix::MAX_CHIPS));
+        if(_outputs == 1) {
+            set_mono();
+        }
+        else {
+            set_stereo();
+        }
+        update();
+    };
+
+    return configure();
+}
+
+auto Mixer::get_gain(uint32_t output, uint32_t input) const -> float
+{
+    if((output >= MAX_OUTPUTS) || (input >= (_chips * 3))) {
+        throw std::runtime_error("invalid mixer gain");
+    }
+    return _matrix.gains_f32[output][input];
+}
+
+auto Mixer::set_gain(uint32_t output, uint32_t input, float gain) -> void
+{
+    if((output >= MAX_OUTPUTS) || (input >= (_chips * 3))) {
+        throw std::runtime_error("invalid mixer gain");
+    }
+    _matrix.gains_f32[output][input] = gain;
+    update();
+}
+
+auto Mixer::mix(const Output* input, float* const* outputs, size_t count) const -> void
+{
+    switch(_outputs) {
+        case 1:
+            _kernels.mix_mono_f32(input, outputs[0], count, _matrix);
+            break;
+        case 2:
+            _kernels.mix_stereo_f32(input, outputs[0], outputs[1], count, _matrix);
+            break;
+        case 4:
+            _kernels.mix_quad_f32(input, outputs[0], outputs[1], outputs[2], outputs[3], count, _matrix);
+            break;
+        default:
+            break;
+    }
+}
+
+auto Mixer::mix(const OutputInt32* input, int32_t* const* outputs, size_t count) const -> void
+{
+    switch(_outputs) {
+        case 1:
+            _kernels.mix_mono_s16(input, outputs[0], count, _matrix);
+            break;
+        case 2:
+            _kernels.mix_stereo_s16(input, outputs[0], outputs[1], count, _matrix);
+            break;
+        case 4:
+            _kernels.mix_quad_s16(input, outputs[0], outputs[1], outputs[2], outputs[3], count, _matrix);
+            break;
+        default:
+            break;
+    }
+}
+
+auto Mixer::update() -> void
+{
+    const uint32_t inputs = (_chips * 3);
+
+    _matrix.chips = _chips;
+    for(uint32_t row = 0; row < MAX_OUTPUTS; ++row) {
+        float   (&gains_f32)[MixMatrix::MAX_INPUTS](_matrix.gains_f32[row]);
+        int32_t (&gains_s16)[MixMatrix::MAX_INPUTS](_matrix.gains_s16[row]);
+        for(uint32_t input = 0; input < MixMatrix::MAX_INPUTS; ++input) {
+            gains_s16[input] = static_cast<int32_t>(std::lrint(gains_f32[input] * MixerTraits::Q8));
+        }
+        _matrix.norms_f32[row] = MixerTraits::get_norm(gains_f32, inputs);
+        _matrix.norms_s16[row] = MixerTraits::get_norm(gains_s16, inputs);
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,100 @@
+/*
+ * aym-mixer.h - Copyright (c) 2023-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __AYM_Mixer_h__
+#define __AYM_Mixer_h__
+
+#include "aym-emulator.h"
+#include "aym-kernels.h"
+
+// ---------------------------------------------------------------------------
+// aym::Panning
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+enum Panning
+{
+    PANNING_INVALID = -1,
+    PANNING_DEFAULT =  0,
+    PANNING_ABC     =  1,
+    PANNING_ACB     =  2,
+    PANNING_BAC     =  3,
+    PANNING_MONO    =  4,
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::Mixer
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+class Mixer
+{
+public: // public interface
+    static constexpr uint32_t MAX_OUTPUTS = 4;
+
+    Mixer(const Kernels& kernels);
+
+    Mixer(Mixer&&) = delete;
+
+    Mixer(const Mixer&) = delete;
+
+    Mixer& operator=(Mixer&&) = delete;
+
+    Mixer& operator=(const Mixer&) = delete;
+
+    virtual ~Mixer() = default;
+
+    auto configure(Panning panning, uint32_t outputs, uint32_t chips) -> void;
+
+    auto get_outputs() const -> uint32_t
+    {
+        return _outputs;
+    }
+
+    auto get_chips() const -> uint32_t
+    {
+        return _chips;
+    }
+
+    auto get_gain(uint32_t output, uint32_t input) const -> float;
+
+    auto set_gain(uint32_t output, uint32_t input, float gain) -> void;
+
+    auto mix(const Output* input, float* const* outputs, size_t count) const -> void;
+
+    auto mix(const OutputInt32* input, int32_t* const* outputs, size_t count) const -> void;
+
+protected: // protected interface
+    auto update() -> void;
+
+protected: // protected data
+    const Kernels& _kernels;
+    uint32_t       _outputs;
+    uint32_t       _chips;
+    MixMatrix      _matrix;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __AYM_Mixer_h__ */
@@ -23,6 +23,7 @@
 #include <cstring>
 #include <cstdint>
 #include <cstdarg>
+#include <cmath>
 #include <unistd.h>
 #include <memory>
 #include <string>
@@ -31,9 +32,207 @@
 #include <thread>
 #include <mutex>
 #include <iostream>
+#include <algorithm>
+#include <exception>
 #include <stdexcept>
+#include <type_traits>
 #include "lha-stream.h"
 #include "aym-player.h"
+#include "console.h"
+
+// ---------------------------------------------------------------------------
+// Some useful macros
+// ---------------------------------------------------------------------------
+
+#ifndef countof
+#define countof(array) (sizeof(array) / sizeof(array[0]))
+#endif
+
+// ---------------------------------------------------------------------------
+// <anonymous>::ArchiveTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct ArchiveTraits
+{
+    static auto load(const std::string& filename, ym::Archive& archive) -> void
+    {
+        auto ym_create = [](char* filename) -> void
+        {
+            const int rc = ::mkstemp(filename);
+
+            if(rc >= 0) {
+                static_cast<void>(::close(rc));
+            }
+            else {
+                throw std::runtime_error("mkstemp() has failed");
+            }
+        };
+
+        auto ym_extract = [](const std::string& archive, const std::string& output) -> void
+        {
+            lha::Stream stream(archive);
+            lha::Reader reader(stream);
+
+            if(reader.next() != false) {
+                reader.extract(output);
+            }
+        };
+
+        auto ym_import = [](const std::string& filename, ym::Archive& archive) -> void
+        {
+            ym::Reader reader(filename, archive);
+
+            reader.read();
+        };
+
+        auto ym_remove = [](const std::string& filename) -> void
+        {
+            const int rc = ::unlink(filename.c_str());
+
+            if((rc != 0) && (errno != ENOENT)) {
+                throw std::runtime_error("unlink() has failed");
+            }
+        };
+
+        auto ym_load_uncompressed = [&]() -> bool
+        {
+            ym::Reader reader(filename, archive);
+
+            if(reader.probe()) {
+                reader.read();
+                return true;
+            }
+            return false;
+        };
+
+        auto ym_load_compressed = [&]() -> void
+        {
+            char extracted[] = "/tmp/aym-player-XXXXXX";
+            try {
+                ym_create(extracted);
+                ym_extract(filename, extracted);
+                ym_import(extracted, archive);
+                ym_remove(extracted);
+            }
+            catch(...) {
+                ym_remove(extracted);
+                throw;
+            }
+        };
+
+        auto ym_load = [&]() -> void
+        {
+            if(ym_load_uncompressed() == false) {
+                ym_load_compressed();
+            }
+        };
+
+        return ym_load();
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::KernelsTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct KernelsTraits
+{
+    using Kernels  = aym::Kernels;
+    using Settings = aym::Settings;
+
+    static auto get(const Settings& settings) -> const Kernels&
+    {
+        const std::string& name(settings.get_kernels());
+
+        if(name.empty()) {
+            return Kernels::get();
+        }
+        return Kernels::get(name);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::SequencerTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct SequencerTraits
+{
+    using Music    = aym::Music;
+    using Emulator = aym::Emulator;
+
+    template <typename Ports>
+    static auto load_frame(const Music& music, const ym::Archive& archive, Emulator& emulator, Ports& ports, const uint8_t touched) -> void
+    {
+        const auto& frame      = archive.frames[music.index];
+        uint16_t    dirty_mask = 0x3fff;
+
+        if(music.index > 1) {
+            const auto& previous = archive.frames[music.index - 1];
+            dirty_mask = 0x2000;
+            for(int reg = 0; reg < 13; ++reg) {
+                if(frame.data[reg] != previous.data[reg]) {
+                    dirty_mask |= (1 << reg);
+                }
+            }
+        }
+        if(frame.data[13] == 0xff) {
+            dirty_mask &= ~0x2000;
+        }
+        dirty_mask |= (static_cast<uint16_t>(touched) << 8);
+        emulator.load_frame(ports, frame.data, dirty_mask);
+    }
+
+    template <typename Ports>
+    static auto clock(Music& music, const ym::Archive& archive, Emulator& emulator, Ports& ports, const uint8_t touched) -> void
+    {
+        if(music.index >= music.count) {
+            return;
+        }
+        if(++music.index < music.count) {
+            load_frame(music, archive, emulator, ports, touched);
+        }
+        else {
+            emulator.reset();
+        }
+    }
+
+    template <typename Ports>
+    static auto process(Music& music, const ym::Archive& archive, Emulator& emulator, Ports& ports, const uint8_t touched, const uint32_t samplerate) -> bool
+    {
+        if((music.ticks += music.clock) >= samplerate) {
+            do {
+                clock(music, archive, emulator, ports, touched);
+            } while((music.ticks -= samplerate) >= samplerate);
+            return true;
+        }
+        return false;
+    }
+
+    static auto get_pending(const Music& music, const uint32_t samplerate) -> uint32_t
+    {
+        if(music.clock != 0) {
+            return ((samplerate - 1) - music.ticks) / music.clock;
+        }
+        return UINT32_MAX;
+    }
+
+    static auto skip(Music& music, const uint32_t samples) -> void
+    {
+        music.ticks += (samples * music.clock);
+    }
+};
+
+}
 
 // ---------------------------------------------------------------------------
 // aym::PlayerProcessor
@@ -41,292 +240,1326 @@
 
 namespace aym {
 
-PlayerProcessor::PlayerProcessor(AudioDevice& device, const Settings& settings)
+PlayerProcessor::PlayerProcessor(AudioDevice& device, const Settings& settings)
+    : AudioProcessor(device)
+    , _interval(settings.get_keyframe_interval() != 0 ? settings.get_keyframe_interval() : 2000)
+    , _synthesis(settings.get_synthesis())
+    , _kernels(KernelsTraits::get(settings))
+    , _mixer(_kernels)
+    , _filter(_kernels)
+    , _archive()
+    , _emulator(settings.get_chip(), *this)
+    , _resampler()
+    , _blep()
+    , _music()
+    , _sound()
+    , _effects()
+    , _native()
+    , _audio()
+    , _index()
+{
+    _emulator.set_output_stage(settings.get_output_stage());
+    _mixer.configure(settings.get_panning(), _device->playback.channels, 1);
+    _filter.configure(settings.get_filter_profile(), _device->sampleRate);
+    _resampler.configure(_sound.clock, _device->sampleRate);
+    _blep.configure(_sound.clock, _device->sampleRate);
+}
+
+void PlayerProcessor::process(const void* input, void* output, const uint32_t count)
+{
+    const auto format = _device->playback.format;
+
+    auto render = [&](auto& psg_buffer) -> void
+    {
+        for(uint32_t index = 0; index < count;) {
+            const uint32_t samples = std::min(count - index, static_cast<uint32_t>(countof(psg_buffer)));
+            render_sound(psg_buffer, samples);
+            mix_sound(psg_buffer, output, index, samples);
+            index += samples;
+        }
+    };
+
+    auto render_f32 = [&]() -> void
+    {
+        Output psg_buffer[256];
+
+        render(psg_buffer);
+    };
+
+    auto render_s16 = [&]() -> void
+    {
+        OutputInt32 psg_buffer[256];
+
+        render(psg_buffer);
+    };
+
+    auto process = [&]() -> void
+    {
+        const MutexLock lock(_mutex);
+
+        switch(format) {
+            case ma_format_s16:
+                render_s16();
+                break;
+            default:
+                render_f32();
+                break;
+        }
+    };
+
+    return process();
+}
+
+bool PlayerProcessor::playing()
+{
+    const MutexLock lock(_mutex);
+
+    if(_music.index < _music.count) {
+        return true;
+    }
+    return false;
+}
+
+void PlayerProcessor::load(const std::string& filename)
+{
+    const MutexLock lock(_mutex);
+
+    auto ym_finalize = [&]() -> void
+    {
+        _music.ticks = 0;
+        _music.clock = _archive.header.framerate;
+        _music.index = 0;
+        _music.count = _archive.header.frames;
+        _sound.clock = _archive.header.frequency;
+        _effects     = Effects();
+        _emulator.reset();
+        _resampler.configure(_sound.clock, _device->sampleRate);
+        _blep.configure(_sound.clock, _device->sampleRate);
+        _resampler.reset();
+        _blep.reset();
+        switch(_archive.header.magic) {
+            case 0x594d3521: /* YM5! */
+                _effects.version = 5;
+                break;
+            case 0x594d3621: /* YM6! */
+                _effects.version = 6;
+                break;
+            default:
+                break;
+        }
+    };
+
+    auto ym_index = [&]() -> void
+    {
+        const Music    music(_music);
+        const Effects  effects(_effects);
+        const uint64_t interval = (static_cast<uint64_t>(_interval) * _music.clock) / 1000;
+        _index.interval = static_cast<uint32_t>(std::max(interval, static_cast<uint64_t>(1)));
+        _index.keyframes.clear();
+        if(_music.clock != 0) {
+            replay(_music.count + 1, true);
+        }
+        if(_effects.throttled != 0) {
+            Console::alertln("warning: %s: effect rate clamped on %u frame(s) to fit the register-write queue", filename.c_str(), _effects.throttled);
+        }
+        _emulator.reset();
+        _music   = music;
+        _effects = effects;
+    };
+
+    auto ym_load = [&]() -> void
+    {
+        ArchiveTraits::load(filename, _archive);
+        ym_finalize();
+        ym_index();
+    };
+
+    return ym_load();
+}
+
+void PlayerProcessor::seek(const uint32_t milliseconds)
+{
+    const MutexLock lock(_mutex);
+
+    const uint64_t frame  = (static_cast<uint64_t>(milliseconds) * _music.clock) / 1000;
+    const uint32_t target = static_cast<uint32_t>(std::min(std::max(frame, static_cast<uint64_t>(1)), static_cast<uint64_t>(_music.count)));
+
+    auto restore = [&]() -> void
+    {
+        const uint32_t slot = (target / _index.interval);
+        if((slot != 0) && (slot <= _index.keyframes.size())) {
+            const Keyframe& keyframe(_index.keyframes[slot - 1]);
+            _music   = keyframe.music;
+            _effects = keyframe.effects;
+            _emulator.restore(keyframe.snapshot);
+            _resampler.reset();
+            _blep.reset();
+        }
+        else {
+            rewind_music();
+        }
+    };
+
+    auto seek = [&]() -> void
+    {
+        if(_music.clock != 0) {
+            restore();
+            replay(target, false);
+        }
+    };
+
+    return seek();
+}
+
+void PlayerProcessor::stems(float* channel0, float* channel1, float* channel2, const uint32_t count)
+{
+    const MutexLock lock(_mutex);
+
+    const auto samplerate = _device->sampleRate;
+
+    for(uint32_t index = 0; index < count;) {
+        process_music();
+        const uint32_t samples = 1 + skip_music(count - index - 1);
+        _emulator.render((channel0 + index), (channel1 + index), (channel2 + index), samples, _sound.clock, samplerate);
+        index += samples;
+    }
+}
+
+void PlayerProcessor::stems(int16_t* channel0, int16_t* channel1, int16_t* channel2, const uint32_t count)
+{
+    const MutexLock lock(_mutex);
+
+    const auto samplerate = _device->sampleRate;
+
+    for(uint32_t index = 0; index < count;) {
+        process_music();
+        const uint32_t samples = 1 + skip_music(count - index - 1);
+        _emulator.render((channel0 + index), (channel1 + index), (channel2 + index), samples, _sound.clock, samplerate);
+        index += samples;
+    }
+}
+
+auto PlayerProcessor::get_length() -> uint64_t
+{
+    const MutexLock lock(_mutex);
+
+    const uint64_t samplerate = _device->sampleRate;
+
+    if(_music.clock != 0) {
+        return ((static_cast<uint64_t>(_music.count) * samplerate) + (_music.clock - 1)) / _music.clock;
+    }
+    return 0;
+}
+
+auto PlayerProcessor::get_position() -> uint64_t
+{
+    const MutexLock lock(_mutex);
+
+    if(_music.clock != 0) {
+        return get_position(_music);
+    }
+    return 0;
+}
+
+auto PlayerProcessor::get_checkpoints() -> std::vector<uint64_t>
+{
+    const MutexLock lock(_mutex);
+
+    std::vector<uint64_t> checkpoints;
+
+    checkpoints.reserve(_index.keyframes.size() + 1);
+    checkpoints.push_back(0);
+    for(auto& keyframe : _index.keyframes) {
+        checkpoints.push_back(get_position(keyframe.music));
+    }
+    return checkpoints;
+}
+
+void PlayerProcessor::fork(const PlayerProcessor& processor)
+{
+    const MutexLock lock(_mutex);
+
+    _archive = processor._archive;
+    _music   = processor._music;
+    _sound   = processor._sound;
+    _effects = processor._effects;
+    _index   = processor._index;
+    _resampler.configure(_sound.clock, _device->sampleRate);
+    _blep.configure(_sound.clock, _device->sampleRate);
+    rewind_music();
+}
+
+void PlayerProcessor::locate(const uint64_t position)
+{
+    const MutexLock lock(_mutex);
+
+    const auto     samplerate = _device->sampleRate;
+    const uint64_t target     = position - std::min(position, static_cast<uint64_t>(get_latency()));
+    uint64_t       current    = 0;
+
+    auto restore = [&]() -> void
+    {
+        rewind_music();
+        for(auto& keyframe : _index.keyframes) {
+            const uint64_t offset = get_position(keyframe.music);
+            if(offset > target) {
+                break;
+            }
+            _music   = keyframe.music;
+            _effects = keyframe.effects;
+            _emulator.restore(keyframe.snapshot);
+            _resampler.reset();
+            _blep.reset();
+            current = offset;
+        }
+    };
+
+    auto replay = [&]() -> void
+    {
+        while(current < target) {
+            const uint32_t remaining = static_cast<uint32_t>(std::min(target - current, static_cast<uint64_t>(samplerate)));
+            process_music();
+            const uint32_t samples = 1 + skip_music(remaining - 1);
+            _emulator.skip(samples, _sound.clock, samplerate);
+            current += samples;
+        }
+    };
+
+    auto warmup = [&](auto& psg_buffer) -> void
+    {
+        while(current < position) {
+            const uint32_t samples = static_cast<uint32_t>(std::min((position - current), static_cast<uint64_t>(countof(psg_buffer))));
+            render_sound(psg_buffer, samples);
+            current += samples;
+        }
+    };
+
+    auto warmup_f32 = [&]() -> void
+    {
+        Output psg_buffer[256];
+
+        warmup(psg_buffer);
+    };
+
+    auto warmup_s16 = [&]() -> void
+    {
+        OutputInt32 psg_buffer[256];
+
+        warmup(psg_buffer);
+    };
+
+    auto locate = [&]() -> void
+    {
+        if(_music.clock != 0) {
+            restore();
+            replay();
+            switch(_device->playback.format) {
+                case ma_format_s16:
+                    warmup_s16();
+                    break;
+                default:
+                    warmup_f32();
+                    break;
+            }
+        }
+    };
+
+    return locate();
+}
+
+void PlayerProcessor::generate(Output* buffer, const uint32_t count)
+{
+    const MutexLock lock(_mutex);
+
+    return render_sound(buffer, count);
+}
+
+void PlayerProcessor::generate(OutputInt32* buffer, const uint32_t count)
+{
+    const MutexLock lock(_mutex);
+
+    return render_sound(buffer, count);
+}
+
+void PlayerProcessor::mix(const Output* buffer, void* output, const uint32_t count)
+{
+    const MutexLock lock(_mutex);
+
+    return mix_sound(buffer, output, 0, count);
+}
+
+void PlayerProcessor::mix(const OutputInt32* buffer, void* output, const uint32_t count)
+{
+    const MutexLock lock(_mutex);
+
+    return mix_sound(buffer, output, 0, count);
+}
+
+auto PlayerProcessor::get_position(const Music& music) const -> uint64_t
+{
+    const uint64_t samplerate = _device->sampleRate;
+
+    return ((static_cast<uint64_t>(music.index) * samplerate) + music.ticks) / music.clock;
+}
+
+void PlayerProcessor::rewind_music()
+{
+    _music.ticks = 0;
+    _music.index = 0;
+    _effects.touched = 0;
+    for(auto& effect : _effects.voices) {
+        effect = Effect();
+    }
+    _emulator.reset();
+    _resampler.reset();
+    _blep.reset();
+}
+
+void PlayerProcessor::process_music()
+{
+    const auto samplerate = _device->sampleRate;
+
+    if(SequencerTraits::process(_music, _archive, _emulator, *this, _effects.touched, samplerate)) {
+        process_effects();
+    }
+}
+
+void PlayerProcessor::process_effects()
+{
+    constexpr uint64_t mfp_clock     = 2457600;
+    constexpr uint16_t mfp_prediv[8] = { 0, 4, 10, 16, 50, 64, 100, 200 };
+    constexpr uint8_t  drum_level[16] = { 0, 7, 9, 10, 11, 12, 12, 13, 13, 14, 14, 14, 14, 15, 15, 15 };
+    const auto         samplerate    = _device->sampleRate;
+    const auto&        header        = _archive.header;
+    const auto&        frame         = _archive.frames[_music.index];
+    const uint32_t     start         = _emulator->ticks;
+    uint64_t           limit         = 0;
+
+    auto get_limit = [&]() -> uint64_t
+    {
+        const uint64_t samples = 1 + (((samplerate - 1) - _music.ticks) / _music.clock);
+        const uint64_t ticks   = (_emulator->remainder + (samples * _sound.clock)) / samplerate;
+
+        return ticks * mfp_clock;
+    };
+
+    auto push = [&](const uint64_t phase, const uint8_t index, const uint8_t value) -> bool
+    {
+        if(_emulator.get_pending() < WriteQueue::SIZE) {
+            _emulator.push(static_cast<uint32_t>(start + (phase / mfp_clock)), index, value);
+            return true;
+        }
+        return false;
+    };
+
+    auto get_drum_level = [&](uint8_t value) -> uint8_t
+    {
+        if((header.attributes & 0x04) != 0) {
+            return (value & 0x0f);
+        }
+        if((header.attributes & 0x02) != 0) {
+            value ^= 0x80;
+        }
+        return drum_level[value >> 4];
+    };
+
+    auto stop = [&]() -> void
+    {
+        _effects.touched = 0;
+        for(auto& effect : _effects.voices) {
+            if(effect.type != Effect::DIGIDRUM) {
+                effect.type = Effect::NONE;
+            }
+        }
+    };
+
+    auto start_effect = [&](const uint8_t type, const uint8_t code, const uint8_t prediv, const uint8_t count) -> void
+    {
+        const int voice = ((code >> 4) & 3) - 1;
+        if(voice < 0) {
+            return;
+        }
+        Effect&        effect(_effects.voices[voice]);
+        const Effect   previous(effect);
+        const uint8_t  level  = frame.data[8 + voice];
+        const uint64_t period = static_cast<uint64_t>(mfp_prediv[(prediv >> 5) & 7]) * count * _sound.clock;
+        if(period == 0) {
+            return;
+        }
+        effect        = Effect();
+        effect.type   = type;
+        effect.period = period;
+        switch(type) {
+            case Effect::SID:
+                effect.level  = (level & 0x0f);
+                effect.output = effect.level;
+                effect.phase  = period;
+                if((previous.type == Effect::SID) && (previous.period == period)) {
+                    effect.output = (previous.output != 0 ? effect.level : 0);
+                    effect.phase  = previous.phase;
+                }
+                break;
+            case Effect::DIGIDRUM:
+                effect.sample = (level & 0x1f);
+                if(effect.sample >= header.samples) {
+                    effect.type = Effect::NONE;
+                }
+                break;
+            case Effect::SYNC_BUZZER:
+                effect.level = (level & 0x0f);
+                effect.phase = period;
+                if((previous.type == Effect::SYNC_BUZZER) && (previous.period == period)) {
+                    effect.phase = previous.phase;
+                }
+                break;
+            default:
+                break;
+        }
+    };
+
+    auto decode = [&]() -> void
+    {
+        constexpr uint8_t ym6_types[4] = { Effect::SID, Effect::DIGIDRUM, Effect::SID, Effect::SYNC_BUZZER };
+        if(_effects.version == 6) {
+            start_effect(ym6_types[frame.data[1] >> 6], frame.data[1], frame.data[6], frame.data[14]);
+            start_effect(ym6_types[frame.data[3] >> 6], frame.data[3], frame.data[8], frame.data[15]);
+        }
+        else {
+            start_effect(Effect::SID, frame.data[1], frame.data[6], frame.data[14]);
+            start_effect(Effect::DIGIDRUM, frame.data[3], frame.data[8], frame.data[15]);
+        }
+    };
+
+    auto prime = [&]() -> bool
+    {
+        for(int voice = 0; voice < 3; ++voice) {
+            const Effect& effect(_effects.voices[voice]);
+            if((effect.type != Effect::SID) && (effect.type != Effect::DIGIDRUM)) {
+                continue;
+            }
+            _effects.touched |= (1 << voice);
+            if((effect.type == Effect::SID) || (effect.position != 0)) {
+                if(push(0, (8 + voice), effect.output) == false) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    auto trigger = [&](const int voice) -> bool
+    {
+        Effect& effect(_effects.voices[voice]);
+        bool    result = true;
+        switch(effect.type) {
+            case Effect::SID:
+                effect.output = (effect.output != 0 ? 0 : effect.level);
+                result = push(effect.phase, (8 + voice), effect.output);
+                break;
+            case Effect::DIGIDRUM:
+                if(effect.position < _archive.samples[effect.sample].size) {
+                    effect.output = get_drum_level(_archive.samples[effect.sample].data[effect.position++]);
+                    result = push(effect.phase, (8 + voice), effect.output);
+                }
+                else {
+                    effect.type = Effect::NONE;
+                    result = push(effect.phase, (8 + voice), (frame.data[8 + voice] & 0x1f));
+                }
+                break;
+            case Effect::SYNC_BUZZER:
+                result = push(effect.phase, 13, effect.level);
+                break;
+            default:
+                break;
+        }
+        effect.phase += effect.step;
+        return result;
+    };
+
+    auto throttle = [&]() -> void
+    {
+        const uint64_t pending = _emulator.get_pending();
+        uint64_t       voices  = 0;
+        bool           clamped = false;
+        for(auto& effect : _effects.voices) {
+            if(effect.type != Effect::NONE) {
+                ++voices;
+            }
+        }
+        if(voices == 0) {
+            return;
+        }
+        const uint64_t space  = WriteQueue::SIZE - std::min((pending + voices), static_cast<uint64_t>(WriteQueue::SIZE));
+        const uint64_t budget = std::max((space / voices), static_cast<uint64_t>(1));
+        for(auto& effect : _effects.voices) {
+            if(effect.type == Effect::NONE) {
+                continue;
+            }
+            effect.step = effect.period;
+            if(effect.phase >= limit) {
+                continue;
+            }
+            const uint64_t distance = (limit - 1 - effect.phase);
+            if((1 + (distance / effect.step)) > budget) {
+                effect.step = (budget > 1 ? 1 + (distance / (budget - 1)) : limit);
+                clamped = true;
+            }
+        }
+        if(clamped) {
+            ++_effects.throttled;
+        }
+    };
+
+    auto schedule = [&]() -> void
+    {
+        if(prime() == false) {
+            ++_effects.throttled;
+            return;
+        }
+        for(;;) {
+            int voice = -1;
+            for(int index = 0; index < 3; ++index) {
+                const Effect& effect(_effects.voices[index]);
+                if((effect.type != Effect::NONE) && (effect.phase < limit)) {
+                    if((voice < 0) || (effect.phase < _effects.voices[voice].phase)) {
+                        voice = index;
+                    }
+                }
+            }
+            if(voice < 0) {
+                break;
+            }
+            if(trigger(voice) == false) {
+                ++_effects.throttled;
+                break;
+            }
+        }
+    };
+
+    auto rebase = [&]() -> void
+    {
+        for(auto& effect : _effects.voices) {
+            effect.phase = (effect.phase > limit ? effect.phase - limit : 0);
+        }
+    };
+
+    auto process = [&]() -> void
+    {
+        stop();
+        if((_effects.version != 0) && (_music.index < _music.count)) {
+            limit = get_limit();
+            decode();
+            throttle();
+            schedule();
+            rebase();
+        }
+    };
+
+    return process();
+}
+
+auto PlayerProcessor::get_latency() const -> uint32_t
+{
+    const uint64_t samplerate = _device->sampleRate;
+
+    switch(_synthesis) {
+        case Synthesis::SYNTHESIS_FIR:
+            if(_sound.clock != 0) {
+                return static_cast<uint32_t>(2 + ((static_cast<uint64_t>(_resampler.get_taps()) * 8 * samplerate) / _sound.clock));
+            }
+            break;
+        case Synthesis::SYNTHESIS_BLEP:
+            return 2 + _blep.get_taps();
+        default:
+            break;
+    }
+    return 0;
+}
+
+void PlayerProcessor::render_sound(Output* buffer, const uint32_t count)
+{
+    return synthesize(buffer, _native.output, count);
+}
+
+void PlayerProcessor::render_sound(OutputInt32* buffer, const uint32_t count)
+{
+    return synthesize(buffer, _native.output_s16, count);
+}
+
+template <typename T>
+void PlayerProcessor::synthesize(BasicOutput<T>* buffer, std::vector<BasicOutput<T>>& native, const uint32_t count)
+{
+    const auto  samplerate = _device->sampleRate;
+    OutputLevel levels[256];
+
+    auto hold = [&](BasicOutput<T>* output, const uint32_t length) -> void
+    {
+        for(uint32_t index = 0; index < length;) {
+            process_music();
+            const uint32_t samples = 1 + skip_music(length - index - 1);
+            _emulator.render((levels + index), samples, _sound.clock, samplerate);
+            index += samples;
+        }
+        _emulator.convert(levels, output, length);
+    };
+
+    auto reserve = [&](const uint32_t length) -> void
+    {
+        const uint64_t steps = 2 + ((((static_cast<uint64_t>(length) * _sound.clock) / samplerate) + 8) / 8);
+        if(_native.levels.size() < steps) {
+            _native.levels.resize(steps);
+        }
+        if(_native.offsets.size() < steps) {
+            _native.offsets.resize(steps);
+        }
+        if(native.size() < steps) {
+            native.resize(steps);
+        }
+    };
+
+    auto fir = [&](BasicOutput<T>* output, const uint32_t length) -> void
+    {
+        reserve(length);
+        for(uint32_t index = 0; index < length;) {
+            process_music();
+            const uint32_t samples   = 1 + skip_music(length - index - 1);
+            const uint32_t phase     = (_emulator->ticks & 0x07);
+            const uint32_t remainder = (_emulator->remainder);
+            const size_t   steps     = _emulator.oversample(_native.levels.data(), samples, _sound.clock, samplerate);
+            _emulator.convert(_native.levels.data(), native.data(), steps);
+            _resampler.process(native.data(), steps, (output + index), samples, phase, remainder);
+            index += samples;
+        }
+    };
+
+    auto blep = [&](BasicOutput<T>* output, const uint32_t length) -> void
+    {
+        reserve(length);
+        for(uint32_t index = 0; index < length;) {
+            process_music();
+            const uint32_t samples   = 1 + skip_music(length - index - 1);
+            const uint32_t remainder = (_emulator->remainder);
+            const size_t   edges     = _emulator.transitions(_native.levels.data(), _native.offsets.data(), samples, _sound.clock, samplerate);
+            _emulator.convert(_native.levels.data(), native.data(), edges);
+            _blep.process(native.data(), _native.offsets.data(), edges, (output + index), samples, remainder);
+            index += samples;
+        }
+    };
+
+    auto integrate = [&](BasicOutput<T>* output, const uint32_t samples, const size_t edges, const uint32_t remainder) -> void
+    {
+        const uint64_t clock = _sound.clock;
+        const double   scale = (clock != 0 ? 1.0 / static_cast<double>(clock) : 0.0);
+        size_t         edge  = 1;
+
+        auto store = [&](const double value, T& result) -> void
+        {
+            if(std::is_integral<T>::value) {
+                result = static_cast<T>(std::lrint(value * scale));
+            }
+            else {
+                result = static_cast<T>(value * scale);
+            }
+        };
+
+        for(uint32_t index = 0; index < samples; ++index) {
+            const uint64_t upper    = remainder + ((index + 1) * clock);
+            uint64_t       position = upper - clock;
+            double         sum[3]   = {};
+            while((edge < edges) && ((static_cast<uint64_t>(_native.offsets[edge]) * samplerate) < upper)) {
+                const uint64_t moment = (static_cast<uint64_t>(_native.offsets[edge]) * samplerate);
+                const double   length = static_cast<double>(moment - position);
+                sum[0] += native[edge - 1].channel0 * length;
+                sum[1] += native[edge - 1].channel1 * length;
+                sum[2] += native[edge - 1].channel2 * length;
+                position = moment;
+                ++edge;
+            }
+            const double length = static_cast<double>(upper - position);
+            sum[0] += native[edge - 1].channel0 * length;
+            sum[1] += native[edge - 1].channel1 * length;
+            sum[2] += native[edge - 1].channel2 * length;
+            store(sum[0], output[index].channel0);
+            store(sum[1], output[index].channel1);
+            store(sum[2], output[index].channel2);
+        }
+    };
+
+    auto area = [&](BasicOutput<T>* output, const uint32_t length) -> void
+    {
+        reserve(length);
+        for(uint32_t index = 0; index < length;) {
+            process_music();
+            const uint32_t samples   = 1 + skip_music(length - index - 1);
+            const uint32_t remainder = (_emulator->remainder);
+            const size_t   edges     = _emulator.transitions(_native.levels.data(), _native.offsets.data(), samples, _sound.clock, samplerate);
+            _emulator.convert(_native.levels.data(), native.data(), edges);
+            integrate((output + index), samples, edges, remainder);
+            index += samples;
+        }
+    };
+
+    for(uint32_t index = 0; index < count;) {
+        const uint32_t samples = std::min(count - index, static_cast<uint32_t>(countof(levels)));
+        switch(_synthesis) {
+            case Synthesis::SYNTHESIS_FIR:
+                fir((buffer + index), samples);
+                break;
+            case Synthesis::SYNTHESIS_BLEP:
+                blep((buffer + index), samples);
+                break;
+            case Synthesis::SYNTHESIS_AREA:
+                area((buffer + index), samples);
+                break;
+            default:
+                hold((buffer + index), samples);
+                break;
+        }
+        index += samples;
+    }
+}
+
+void PlayerProcessor::mix_sound(const Output* buffer, void* output, const uint32_t position, const uint32_t count)
+{
+    const auto channels = _device->playback.channels;
+    float      front_left[256];
+    float      front_right[256];
+    float      back_left[256];
+    float      back_right[256];
+    float*     lanes[4] = { front_left, front_right, back_left, back_right };
+
+    auto mix = [&](const uint32_t offset, const uint32_t samples) -> void
+    {
+        auto process = [&](const uint32_t lane) -> void
+        {
+            _kernels.finish_f32(lanes[lane], samples, _audio.volume);
+        };
+
+        auto mono = [&]() -> void
+        {
+            auto* audio_frame = reinterpret_cast<MonoFrameFlt32*>(output) + offset;
+            _mixer.mix(buffer, lanes, samples);
+            _filter.process(lanes, channels, samples);
+            process(0);
+            for(uint32_t index = 0; index < samples; ++index) {
+                audio_frame[index].mono = front_left[index];
+            }
+        };
+
+        auto stereo = [&]() -> void
+        {
+            auto* audio_frame = reinterpret_cast<StereoFrameFlt32*>(output) + offset;
+            _mixer.mix(buffer, lanes, samples);
+            _filter.process(lanes, channels, samples);
+            process(0);
+            process(1);
+            for(uint32_t index = 0; index < samples; ++index) {
+                audio_frame[index].left  = front_left[index];
+                audio_frame[index].right = front_right[index];
+            }
+        };
+
+        auto surround40 = [&]() -> void
+        {
+            auto* audio_frame = reinterpret_cast<Surround40FrameFlt32*>(output) + offset;
+            _mixer.mix(buffer, lanes, samples);
+            _filter.process(lanes, channels, samples);
+            process(0);
+            process(1);
+            process(2);
+            process(3);
+            for(uint32_t index = 0; index < samples; ++index) {
+                audio_frame[index].front_left  = front_left[index];
+                audio_frame[index].front_right = front_right[index];
+                audio_frame[index].back_left   = back_left[index];
+                audio_frame[index].back_right  = back_right[index];
+            }
+        };
+
+        switch(channels) {
+            case 1:
+                mono();
+                break;
+            case 2:
+                stereo();
+                break;
+            case 4:
+                surround40();
+                break;
+            default:
+                break;
+        }
+    };
+
+    for(uint32_t index = 0; index < count;) {
+        const uint32_t samples = std::min(count - index, static_cast<uint32_t>(countof(front_left)));
+        mix((position + index), samples);
+        buffer += samples;
+        index  += samples;
+    }
+}
+
+void PlayerProcessor::mix_sound(const OutputInt32* buffer, void* output, const uint32_t position, const uint32_t count)
+{
+    const auto channels = _device->playback.channels;
+    int32_t    front_left[256];
+    int32_t    front_right[256];
+    int32_t    back_left[256];
+    int32_t    back_right[256];
+    int32_t*   lanes[4] = { front_left, front_right, back_left, back_right };
+    int16_t    lanes_s16[4][256];
+
+    auto mix = [&](const uint32_t offset, const uint32_t samples) -> void
+    {
+        auto process = [&](const uint32_t lane) -> void
+        {
+            _kernels.finish_s16(lanes[lane], lanes_s16[lane], samples, _audio.volume);
+        };
+
+        auto mono = [&]() -> void
+        {
+            auto* audio_frame = reinterpret_cast<MonoFrameInt16*>(output) + offset;
+            _mixer.mix(buffer, lanes, samples);
+            _filter.process(lanes, channels, samples);
+            process(0);
+            for(uint32_t index = 0; index < samples; ++index) {
+                audio_frame[index].mono = lanes_s16[0][index];
+            }
+        };
+
+        auto stereo = [&]() -> void
+        {
+            auto* audio_frame = reinterpret_cast<StereoFrameInt16*>(output) + offset;
+            _mixer.mix(buffer, lanes, samples);
+            _filter.process(lanes, channels, samples);
+            process(0);
+            process(1);
+            for(uint32_t index = 0; index < samples; ++index) {
+                audio_frame[index].left  = lanes_s16[0][index];
+                audio_frame[index].right = lanes_s16[1][index];
+            }
+        };
+
+        auto surround40 = [&]() -> void
+        {
+            auto* audio_frame = reinterpret_cast<Surround40FrameInt16*>(output) + offset;
+            _mixer.mix(buffer, lanes, samples);
+            _filter.process(lanes, channels, samples);
+            process(0);
+            process(1);
+            process(2);
+            process(3);
+            for(uint32_t index = 0; index < samples; ++index) {
+                audio_frame[index].front_left  = lanes_s16[0][index];
+                audio_frame[index].front_right = lanes_s16[1][index];
+                audio_frame[index].back_left   = lanes_s16[2][index];
+                audio_frame[index].back_right  = lanes_s16[3][index];
+            }
+        };
+
+        switch(channels) {
+            case 1:
+                mono();
+                break;
+            case 2:
+                stereo();
+                break;
+            case 4:
+                surround40();
+                break;
+            default:
+                break;
+        }
+    };
+
+    for(uint32_t index = 0; index < count;) {
+        const uint32_t samples = std::min(count - index, static_cast<uint32_t>(countof(front_left)));
+        mix((position + index), samples);
+        buffer += samples;
+        index  += samples;
+    }
+}
+
+auto PlayerProcessor::skip_music(const uint32_t remaining) -> uint32_t
+{
+    const auto     samplerate = _device->sampleRate;
+    const uint32_t samples    = std::min(remaining, SequencerTraits::get_pending(_music, samplerate));
+
+    SequencerTraits::skip(_music, samples);
+    return samples;
+}
+
+void PlayerProcessor::replay(const uint32_t target, const bool indexing)
+{
+    const auto samplerate = _device->sampleRate;
+
+    auto is_pending = [&]() -> bool
+    {
+        return (_music.ticks + _music.clock) >= samplerate;
+    };
+
+    auto add_keyframe = [&]() -> void
+    {
+        Keyframe keyframe;
+        keyframe.music   = _music;
+        keyframe.effects = _effects;
+        _emulator.save(keyframe.snapshot);
+        _index.keyframes.push_back(keyframe);
+    };
+
+    auto replay = [&]() -> void
+    {
+        while(_music.index < _music.count) {
+            if(is_pending()) {
+                const uint32_t next = (_music.index + 1);
+                if(next == target) {
+                    break;
+                }
+                if((indexing != false) && ((next % _index.interval) == 0)) {
+                    add_keyframe();
+                }
+            }
+            process_music();
+            const uint32_t samples = 1 + skip_music(samplerate);
+            _emulator.skip(samples, _sound.clock, samplerate);
+        }
+    };
+
+    return replay();
+}
+
+uint8_t PlayerProcessor::aym_port_a_rd(Emulator& emulator, uint8_t data)
+{
+    return data;
+}
+
+uint8_t PlayerProcessor::aym_port_a_wr(Emulator& emulator, uint8_t data)
+{
+    return data;
+}
+
+uint8_t PlayerProcessor::aym_port_b_rd(Emulator& emulator, uint8_t data)
+{
+    return data;
+}
+
+uint8_t PlayerProcessor::aym_port_b_wr(Emulator& emulator, uint8_t data)
+{
+    return data;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::ChipSetProcessor
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+ChipSetProcessor::ChipSetProcessor(AudioDevice& device, const Settings& settings)
     : AudioProcessor(device)
-    , _archive()
-    , _emulator(settings.get_chip(), *this)
-    , _music()
-    , _sound()
-    , _audio()
+    , _kernels(KernelsTraits::get(settings))
+    , _filter(_kernels)
+    , _chipset(settings.get_chip(), std::max(settings.get_chips(), 1U), *this, _kernels)
+    , _clock(0)
+    , _tracks()
 {
+    for(size_t chip = 0; chip < _chipset.get_count(); ++chip) {
+        _chipset[chip].set_output_stage(settings.get_output_stage());
+    }
+    _chipset.configure(settings.get_panning(), _device->playback.channels);
+    _filter.configure(settings.get_filter_profile(), _device->sampleRate);
 }
 
-void PlayerProcessor::process(const void* input, void* output, const uint32_t count)
+void ChipSetProcessor::process(const void* input, void* output, const uint32_t count)
 {
-    const auto  channels   = _device->playback.channels;
-    const auto  samplerate = _device->sampleRate;
-    const auto& psg_output = _emulator.get_output();
+    const auto format = _device->playback.format;
 
-    auto set_register = [&](const uint8_t index, const uint8_t value) -> void
+    auto render = [&](auto& front_left, auto* const* lanes) -> void
     {
-        if((index == 13) && (value == 0xff)) {
-            return;
+        for(uint32_t index = 0; index < count;) {
+            const uint32_t samples = std::min(count - index, static_cast<uint32_t>(countof(front_left)));
+            render_sound(lanes, samples);
+            mix_sound(lanes, output, index, samples);
+            index += samples;
         }
-        else {
-            _emulator.set_index(index);
-            _emulator.set_value(value);
-        }
-    };
-
-    auto reset = [&]() -> void
-    {
-        _emulator.reset();
     };
 
-    auto clock_music = [&]() -> void
+    auto render_f32 = [&]() -> void
     {
-        if(_music.index >= _music.count) {
-            return;
-        }
-        if(++_music.index < _music.count) {
-            const auto& frame = _archive.frames[_music.index];
-            for(int index = 0; index < 14; ++index) {
-                const auto value = frame.data[index];
-                set_register(index, value);
-            }
-        }
-        else {
-            reset();
-        }
-    };
+        float  front_left[256];
+        float  front_right[256];
+        float  back_left[256];
+        float  back_right[256];
+        float* lanes[4] = { front_left, front_right, back_left, back_right };
 
-    auto process_music = [&]() -> void
-    {
-        if((_music.ticks += _music.clock) >= samplerate) {
-            do {
-                clock_music();
-            } while((_music.ticks -= samplerate) >= samplerate);
-        }
+        render(front_left, lanes);
     };
 
-    auto clock_sound = [&]() -> void
+    auto render_s16 = [&]() -> void
     {
-        _emulator.clock();
-    };
+        int32_t  front_left[256];
+        int32_t  front_right[256];
+        int32_t  back_left[256];
+        int32_t  back_right[256];
+        int32_t* lanes[4] = { front_left, front_right, back_left, back_right };
 
-    auto process_sound = [&]() -> void
-    {
-        if((_sound.ticks += _sound.clock) >= samplerate) {
-            do {
-                clock_sound();
-            } while((_sound.ticks -= samplerate) >= samplerate);
-        }
+        render(front_left, lanes);
     };
 
-    auto dc_block = [&](const int stream, const float input) -> float
+    auto process = [&]() -> void
     {
-        constexpr float attenuation = 0.999f;
-        const float output = (input - _audio.dcb_input[stream]) + (attenuation * _audio.dcb_output[stream]);
-        _audio.dcb_input[stream]  = input;
-        _audio.dcb_output[stream] = output;
-        return output;
-    };
+        const MutexLock lock(_mutex);
 
-    auto clamp = [&](float value) -> float
-    {
-        if(value < -1.0f) {
-            value = -1.0f;
-        }
-        if(value > +1.0f) {
-            value = +1.0f;
+        switch(format) {
+            case ma_format_s16:
+                render_s16();
+                break;
+            default:
+                render_f32();
+                break;
         }
-        return value;
     };
 
-    auto mix_mono = [&](MonoFrameFlt32& audio_frame) -> void
-    {
-        const float mono = (psg_output.channel0 * 1.00f)
-                         + (psg_output.channel1 * 1.00f)
-                         + (psg_output.channel2 * 1.00f)
-                         ;
+    return process();
+}
 
-        audio_frame.mono = clamp(dc_block(0, mono / 3.0f) * _audio.volume);
-    };
+bool ChipSetProcessor::playing()
+{
+    const MutexLock lock(_mutex);
 
-    auto mix_stereo = [&](StereoFrameFlt32& audio_frame) -> void
-    {
-        const float left  = (psg_output.channel0 * 0.75f)
-                          + (psg_output.channel1 * 0.50f)
-                          + (psg_output.channel2 * 0.25f)
-                          ;
+    for(auto& track : _tracks) {
+        if(track.music.index < track.music.count) {
+            return true;
+        }
+    }
+    return false;
+}
 
-        const float right = (psg_output.channel0 * 0.25f)
-                          + (psg_output.channel1 * 0.50f)
-                          + (psg_output.channel2 * 0.75f)
-                          ;
+void ChipSetProcessor::load(const std::vector<std::string>& filenames)
+{
+    const MutexLock lock(_mutex);
 
-        audio_frame.left  = clamp(dc_block(0, left  / 1.5f) * _audio.volume);
-        audio_frame.right = clamp(dc_block(1, right / 1.5f) * _audio.volume);
+    auto has_effects = [&](const ym::Archive& archive) -> bool
+    {
+        switch(archive.header.magic) {
+            case 0x594d3521: /* YM5! */
+            case 0x594d3621: /* YM6! */
+                break;
+            default:
+                return false;
+        }
+        for(uint32_t index = 0; index < archive.header.frames; ++index) {
+            const auto& frame = archive.frames[index];
+            if((((frame.data[1] >> 4) & 3) != 0) || (((frame.data[3] >> 4) & 3) != 0)) {
+                return true;
+            }
+        }
+        return false;
     };
 
-    auto mix_surround40 = [&](Surround40FrameFlt32& audio_frame) -> void
+    auto ym_load = [&](Track& track, const std::string& filename) -> void
     {
-        const float left  = (psg_output.channel0 * 0.75f)
-                          + (psg_output.channel1 * 0.50f)
-                          + (psg_output.channel2 * 0.25f)
-                          ;
-
-        const float right = (psg_output.channel0 * 0.25f)
-                          + (psg_output.channel1 * 0.50f)
-                          + (psg_output.channel2 * 0.75f)
-                          ;
-
-        const float out_l = clamp(dc_block(0, left  / 1.5f) * _audio.volume);
-        const float out_r = clamp(dc_block(1, right / 1.5f) * _audio.volume);
-
-        audio_frame.front_left  = out_l;
-        audio_frame.front_right = out_r;
-        audio_frame.back_left   = out_l;
-        audio_frame.back_right  = out_r;
+        ArchiveTraits::load(filename, track.archive);
+        if(has_effects(track.archive)) {
+            Console::alertln("warning: %s: YM5/YM6 effects are not rendered with several chips", filename.c_str());
+        }
+        track.music.ticks = 0;
+        track.music.clock = track.archive.header.framerate;
+        track.music.index = 0;
+        track.music.count = track.archive.header.frames;
     };
 
-    auto mix = [&](const int index) -> void
+    auto ym_start = [&]() -> void
     {
-        switch(channels) {
-            case 1:
-                mix_mono(reinterpret_cast<MonoFrameFlt32*>(output)[index]);
-                break;
-            case 2:
-                mix_stereo(reinterpret_cast<StereoFrameFlt32*>(output)[index]);
-                break;
-            case 4:
-                mix_surround40(reinterpret_cast<Surround40FrameFlt32*>(output)[index]);
-                break;
-            default:
-                break;
+        _chipset.reset();
+        _clock = 0;
+        for(auto& track : _tracks) {
+            if(_clock == 0) {
+                _clock = track.archive.header.frequency;
+            }
         }
     };
 
-    auto render = [&]() -> void
+    auto load = [&]() -> void
     {
-        const MutexLock lock(_mutex);
-
-        for(uint32_t index = 0; index < count; ++index) {
-            process_music();
-            process_sound();
-            mix(index);
+        const size_t count = std::min(filenames.size(), _chipset.get_count());
+        _tracks.clear();
+        _tracks.resize(count);
+        for(size_t chip = 0; chip < count; ++chip) {
+            ym_load(_tracks[chip], filenames[chip]);
         }
+        _chipset.set_active(std::max(count, static_cast<size_t>(1)));
+        ym_start();
     };
 
-    return render();
+    return load();
 }
 
-bool PlayerProcessor::playing()
+void ChipSetProcessor::process_music()
 {
-    const MutexLock lock(_mutex);
+    const auto samplerate = _device->sampleRate;
 
-    if(_music.index < _music.count) {
-        return true;
+    for(size_t chip = 0; chip < _tracks.size(); ++chip) {
+        Track& track(_tracks[chip]);
+        static_cast<void>(SequencerTraits::process(track.music, track.archive, _chipset[chip], *this, 0, samplerate));
     }
-    return false;
 }
 
-void PlayerProcessor::load(const std::string& filename)
+auto ChipSetProcessor::skip_music(const uint32_t remaining) -> uint32_t
 {
-    const MutexLock lock(_mutex);
+    const auto samplerate = _device->sampleRate;
+    uint32_t   samples    = remaining;
 
-    auto ym_create = [](char* filename) -> void
-    {
-        const int rc = ::mkstemp(filename);
+    for(auto& track : _tracks) {
+        samples = std::min(samples, SequencerTraits::get_pending(track.music, samplerate));
+    }
+    for(auto& track : _tracks) {
+        SequencerTraits::skip(track.music, samples);
+    }
+    return samples;
+}
 
-        if(rc >= 0) {
-            static_cast<void>(::close(rc));
+template <typename T>
+void ChipSetProcessor::render_sound(T* const* lanes, const uint32_t count)
+{
+    const auto samplerate = _device->sampleRate;
+    T*         block[4];
+
+    for(uint32_t index = 0; index < count;) {
+        process_music();
+        const uint32_t samples = 1 + skip_music(count - index - 1);
+        for(uint32_t lane = 0; lane < countof(block); ++lane) {
+            block[lane] = (lanes[lane] + index);
         }
-        else {
-            throw std::runtime_error("mkstemp() has failed");
+        _chipset.render(block, samples, _clock, samplerate);
+        index += samples;
+    }
+}
+
+void ChipSetProcessor::mix_sound(float* const* lanes, void* output, const uint32_t position, const uint32_t count)
+{
+    const auto channels = _device->playback.channels;
+
+    auto mono = [&]() -> void
+    {
+        auto* audio_frame = reinterpret_cast<MonoFrameFlt32*>(output) + position;
+        for(uint32_t index = 0; index < count; ++index) {
+            audio_frame[index].mono = lanes[0][index];
         }
     };
 
-    auto ym_extract = [](const std::string& archive, const std::string& output) -> void
+    auto stereo = [&]() -> void
     {
-        lha::Stream stream(archive);
-        lha::Reader reader(stream);
-
-        if(reader.next() != false) {
-            reader.extract(output);
+        auto* audio_frame = reinterpret_cast<StereoFrameFlt32*>(output) + position;
+        for(uint32_t index = 0; index < count; ++index) {
+            audio_frame[index].left  = lanes[0][index];
+            audio_frame[index].right = lanes[1][index];
         }
     };
 
-    auto ym_import = [](const std::string& filename, ym::Archive& archive) -> void
+    auto surround40 = [&]() -> void
     {
-        ym::Reader reader(filename, archive);
-
-        reader.read();
+        auto* audio_frame = reinterpret_cast<Surround40FrameFlt32*>(output) + position;
+        for(uint32_t index = 0; index < count; ++index) {
+            audio_frame[index].front_left  = lanes[0][index];
+            audio_frame[index].front_right = lanes[1][index];
+            audio_frame[index].back_left   = lanes[2][index];
+            audio_frame[index].back_right  = lanes[3][index];
+        }
     };
 
-    auto ym_remove = [](const std::string& filename) -> void
+    auto mix = [&]() -> void
     {
-        const int rc = ::unlink(filename.c_str());
-
-        if((rc != 0) && (errno != ENOENT)) {
-            throw std::runtime_error("unlink() has failed");
+        _filter.process(lanes, channels, count);
+        for(uint32_t lane = 0; lane < channels; ++lane) {
+            _kernels.finish_f32(lanes[lane], count, 1.0f);
+        }
+        switch(channels) {
+            case 1:
+                return mono();
+            case 2:
+                return stereo();
+            case 4:
+                return surround40();
+            default:
+                break;
         }
     };
 
-    auto ym_finalize = [&]() -> void
+    return mix();
+}
+
+void ChipSetProcessor::mix_sound(int32_t* const* lanes, void* output, const uint32_t position, const uint32_t count)
+{
+    const auto channels = _device->playback.channels;
+    int16_t    lanes_s16[4][256];
+
+    auto mono = [&]() -> void
     {
-        _music.ticks = 0;
-        _music.clock = _archive.header.framerate;
-        _music.index = 0;
-        _music.count = _archive.header.frames;
-        _sound.ticks = 0;
-        _sound.clock = _archive.header.frequency;
+        auto* audio_frame = reinterpret_cast<MonoFrameInt16*>(output) + position;
+        for(uint32_t index = 0; index < count; ++index) {
+            audio_frame[index].mono = lanes_s16[0][index];
+        }
     };
 
-    auto ym_load_uncompressed = [&]() -> bool
+    auto stereo = [&]() -> void
     {
-        ym::Reader reader(filename, _archive);
-
-        if(reader.probe()) {
-            reader.read();
-            ym_finalize();
-            return true;
+        auto* audio_frame = reinterpret_cast<StereoFrameInt16*>(output) + position;
+        for(uint32_t index = 0; index < count; ++index) {
+            audio_frame[index].left  = lanes_s16[0][index];
+            audio_frame[index].right = lanes_s16[1][index];
         }
-        return false;
     };
 
-    auto ym_load_compressed = [&]() -> void
+    auto surround40 = [&]() -> void
     {
-        char extracted[] = "/tmp/aym-player-XXXXXX";
-        try {
-            ym_create(extracted);
-            ym_extract(filename, extracted);
-            ym_import(extracted, _archive);
-            ym_remove(extracted);
-            ym_finalize();
-        }
-        catch(...) {
-            ym_remove(extracted);
-            throw;
+        auto* audio_frame = reinterpret_cast<Surround40FrameInt16*>(output) + position;
+        for(uint32_t index = 0; index < count; ++index) {
+            audio_frame[index].front_left  = lanes_s16[0][index];
+            audio_frame[index].front_right = lanes_s16[1][index];
+            audio_frame[index].back_left   = lanes_s16[2][index];
+            audio_frame[index].back_right  = lanes_s16[3][index];
         }
     };
 
-    auto try_load = [&]() -> void
+    auto mix = [&]() -> void
     {
-        if(ym_load_uncompressed() == false) {
-            ym_load_compressed();
+        _filter.process(lanes, channels, count);
+        for(uint32_t lane = 0; lane < channels; ++lane) {
+            _kernels.finish_s16(lanes[lane], lanes_s16[lane], count, 1.0f);
+        }
+        switch(channels) {
+            case 1:
+                return mono();
+            case 2:
+                return stereo();
+            case 4:
+                return surround40();
+            default:
+                break;
         }
     };
 
-    return try_load();
+    return mix();
 }
 
-uint8_t PlayerProcessor::aym_port_a_rd(Emulator& emulator, uint8_t data)
+uint8_t ChipSetProcessor::aym_port_a_rd(Emulator& emulator, uint8_t data)
 {
     return data;
 }
 
-uint8_t PlayerProcessor::aym_port_a_wr(Emulator& emulator, uint8_t data)
+uint8_t ChipSetProcessor::aym_port_a_wr(Emulator& emulator, uint8_t data)
 {
     return data;
 }
 
-uint8_t PlayerProcessor::aym_port_b_rd(Emulator& emulator, uint8_t data)
+uint8_t ChipSetProcessor::aym_port_b_rd(Emulator& emulator, uint8_t data)
 {
     return data;
 }
 
-uint8_t PlayerProcessor::aym_port_b_wr(Emulator& emulator, uint8_t data)
+uint8_t ChipSetProcessor::aym_port_b_wr(Emulator& emulator, uint8_t data)
 {
     return data;
 }
@@ -344,19 +1577,69 @@ Player::Player(Settings& settings, Playlist& playlist)
     , _playlist(playlist)
     , _device(_settings.get_config())
     , _processor(_device, _settings)
+    , _chipset()
 {
+    if(_settings.get_chips() > 1) {
+        switch(_settings.get_synthesis()) {
+            case Synthesis::SYNTHESIS_FIR:
+            case Synthesis::SYNTHESIS_BLEP:
+            case Synthesis::SYNTHESIS_AREA:
+                throw std::runtime_error("several chips only support the hold synthesis");
+            default:
+                break;
+        }
+        if(_settings.get_dump_layout() == DumpLayout::DUMP_LAYOUT_STEMS) {
+            throw std::runtime_error("stems can not be dumped from several chips");
+        }
+        if(_settings.get_start_offset() != 0) {
+            throw std::runtime_error("several chips can not start at an offset");
+        }
+        if(_settings.get_keyframe_interval() != 0) {
+            throw std::runtime_error("several chips can not be indexed with keyframes");
+        }
+        if(_settings.get_jobs() > 1) {
+            throw std::runtime_error("several chips can not be dumped in parallel");
+        }
+        _device.detach(_processor);
+        _chipset.reset(new ChipSetProcessor(_device, _settings));
+    }
     _settings.set_channels(_device->playback.channels);
     _settings.set_samplerate(_device->sampleRate);
+    _settings.set_format(_device->playback.format == ma_format_s16 ? SampleFormat::FORMAT_S16 : SampleFormat::FORMAT_F32);
 }
 
 void Player::play()
 {
+    auto load_chipset = [&](const std::string& filename) -> void
+    {
+        std::vector<std::string> filenames(1, filename);
+        std::string              next;
+
+        while((filenames.size() < _chipset->get_count()) && (_playlist.next(next) != false)) {
+            filenames.push_back(next);
+        }
+        _chipset->load(filenames);
+    };
+
+    auto load = [&](const std::string& filename) -> void
+    {
+        const uint32_t start_offset = _settings.get_start_offset();
+
+        if(_chipset) {
+            return load_chipset(filename);
+        }
+        _processor.load(filename);
+        if(start_offset != 0) {
+            _processor.seek(start_offset);
+        }
+    };
+
     auto setup = [&]() -> void
     {
         std::string filename;
 
         if(_playlist.get(filename) != false) {
-            _processor.load(filename);
+            load(filename);
         }
     };
 
@@ -372,12 +1655,12 @@ void Player::play()
 
     auto playing = [&]() -> bool
     {
-        bool result = _processor.playing();
+        bool result = (_chipset ? _chipset->playing() : _processor.playing());
 
         if(result == false) {
             std::string filename;
             if((result = _playlist.next(filename)) != false) {
-                _processor.load(filename);
+                load(filename);
             }
         }
         return result;
@@ -404,25 +1687,38 @@ void Player::play()
 void Player::dump()
 {
     constexpr uint32_t length = 16384;
-    float              buffer[length * 2];
+    float              buffer[length * 4];
+    const uint32_t     jobs = std::max(_settings.get_jobs(), 1U);
 
-    auto write_mono = [&](MonoFrameFlt32& audio_frame) -> void
+    std::vector<std::unique_ptr<PlayerProcessor>> workers;
+    std::vector<std::vector<Output>>              psg_f32(jobs);
+    std::vector<std::vector<OutputInt32>>         psg_s16(jobs);
+
+    auto load_chipset = [&](const std::string& filename) -> void
     {
-        const int rc = ::write(STDOUT_FILENO, &audio_frame, sizeof(audio_frame));
-        if(rc < 0) {
-            throw std::runtime_error("write() has failed");
+        std::vector<std::string> filenames(1, filename);
+        std::string              next;
+
+        while((filenames.size() < _chipset->get_count()) && (_playlist.next(next) != false)) {
+            filenames.push_back(next);
         }
+        _chipset->load(filenames);
     };
 
-    auto write_stereo = [&](StereoFrameFlt32& audio_frame) -> void
+    auto load = [&](const std::string& filename) -> void
     {
-        const int rc = ::write(STDOUT_FILENO, &audio_frame, sizeof(audio_frame));
-        if(rc < 0) {
-            throw std::runtime_error("write() has failed");
+        const uint32_t start_offset = _settings.get_start_offset();
+
+        if(_chipset) {
+            return load_chipset(filename);
+        }
+        _processor.load(filename);
+        if(start_offset != 0) {
+            _processor.seek(start_offset);
         }
     };
 
-    auto write_surround40 = [&](Surround40FrameFlt32& audio_frame) -> void
+    auto write_frame = [&](const auto& audio_frame) -> void
     {
         const int rc = ::write(STDOUT_FILENO, &audio_frame, sizeof(audio_frame));
         if(rc < 0) {
@@ -430,33 +1726,194 @@ void Player::dump()
         }
     };
 
-    auto process = [&]() -> void
+    auto write_f32 = [&](const uint32_t channels, const uint32_t index) -> void
     {
-        _processor.process(nullptr, buffer, length);
+        switch(channels) {
+            case 1:
+                write_frame(reinterpret_cast<MonoFrameFlt32*>(buffer)[index]);
+                break;
+            case 2:
+                write_frame(reinterpret_cast<StereoFrameFlt32*>(buffer)[index]);
+                break;
+            case 4:
+                write_frame(reinterpret_cast<Surround40FrameFlt32*>(buffer)[index]);
+                break;
+            default:
+                break;
+        }
+    };
+
+    auto write_s16 = [&](const uint32_t channels, const uint32_t index) -> void
+    {
+        switch(channels) {
+            case 1:
+                write_frame(reinterpret_cast<MonoFrameInt16*>(buffer)[index]);
+                break;
+            case 2:
+                write_frame(reinterpret_cast<StereoFrameInt16*>(buffer)[index]);
+                break;
+            case 4:
+                write_frame(reinterpret_cast<Surround40FrameInt16*>(buffer)[index]);
+                break;
+            default:
+                break;
+        }
+    };
+
+    auto write = [&](const uint32_t count) -> void
+    {
+        const auto format   = _device->playback.format;
         const auto channels = _device->playback.channels;
-        for(uint32_t index = 0; index < length; ++index) {
-            switch(channels) {
-                case 1:
-                    write_mono(reinterpret_cast<MonoFrameFlt32*>(buffer)[index]);
-                    break;
-                case 2:
-                    write_stereo(reinterpret_cast<StereoFrameFlt32*>(buffer)[index]);
-                    break;
-                case 4:
-                    write_surround40(reinterpret_cast<Surround40FrameFlt32*>(buffer)[index]);
+        for(uint32_t index = 0; index < count; ++index) {
+            switch(format) {
+                case ma_format_s16:
+                    write_s16(channels, index);
                     break;
                 default:
+                    write_f32(channels, index);
                     break;
             }
         }
     };
 
+    auto process_serial = [&]() -> void
+    {
+        _processor.process(nullptr, buffer, length);
+        write(length);
+    };
+
+    auto process_stems = [&](auto* channels) -> void
+    {
+        _processor.stems(channels, (channels + length), (channels + (length * 2)), length);
+        const int rc = ::write(STDOUT_FILENO, channels, (sizeof(*channels) * length * 3));
+        if(rc < 0) {
+            throw std::runtime_error("write() has failed");
+        }
+    };
+
+    auto process_parallel = [&](auto& psg_buffers) -> void
+    {
+        const uint64_t        origin = _processor.get_position();
+        const uint64_t        remain = (_processor.get_length() - std::min(origin, _processor.get_length()));
+        const uint64_t        total  = origin + (((remain + (length - 1)) / length) * length);
+        std::vector<uint64_t> bounds(_processor.get_checkpoints());
+
+        auto split = [&]() -> void
+        {
+            while((bounds.empty() == false) && (bounds.back() >= total)) {
+                bounds.pop_back();
+            }
+            bounds.erase(bounds.begin(), std::upper_bound(bounds.begin(), bounds.end(), origin));
+            bounds.insert(bounds.begin(), origin);
+            bounds.push_back(total);
+            for(auto& worker : workers) {
+                worker->fork(_processor);
+            }
+        };
+
+        auto render = [&](const size_t first, const size_t last) -> void
+        {
+            std::vector<std::thread>        threads;
+            std::vector<std::exception_ptr> errors(last - first);
+            for(size_t segment = first; segment < last; ++segment) {
+                auto&          worker     = *workers[segment - first];
+                auto&          psg_buffer = psg_buffers[segment - first];
+                auto&          error      = errors[segment - first];
+                const uint64_t start      = bounds[segment];
+                const uint32_t count      = static_cast<uint32_t>(bounds[segment + 1] - start);
+                psg_buffer.resize(count);
+                threads.emplace_back([&worker, &psg_buffer, &error, start, count]() -> void
+                {
+                    try {
+                        worker.locate(start);
+                        worker.generate(psg_buffer.data(), count);
+                    }
+                    catch(...) {
+                        error = std::current_exception();
+                    }
+                });
+            }
+            for(auto& thread : threads) {
+                thread.join();
+            }
+            for(auto& error : errors) {
+                if(error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        };
+
+        auto mix = [&](const size_t first, const size_t last) -> void
+        {
+            for(size_t segment = first; segment < last; ++segment) {
+                const auto&    psg_buffer = psg_buffers[segment - first];
+                const uint32_t count      = static_cast<uint32_t>(psg_buffer.size());
+                for(uint32_t index = 0; index < count;) {
+                    const uint32_t samples = std::min(count - index, length);
+                    _processor.mix((psg_buffer.data() + index), buffer, samples);
+                    write(samples);
+                    index += samples;
+                }
+            }
+        };
+
+        auto process = [&]() -> void
+        {
+            split();
+            for(size_t first = 0; (first + 1) < bounds.size(); first += jobs) {
+                const size_t last = std::min((first + jobs), (bounds.size() - 1));
+                render(first, last);
+                mix(first, last);
+            }
+            _processor.locate(total);
+        };
+
+        return process();
+    };
+
+    auto process_chipset = [&]() -> void
+    {
+        _chipset->process(nullptr, buffer, length);
+        write(length);
+    };
+
+    auto process = [&]() -> void
+    {
+        if(_chipset) {
+            return process_chipset();
+        }
+        if(_settings.get_dump_layout() == DumpLayout::DUMP_LAYOUT_STEMS) {
+            switch(_device->playback.format) {
+                case ma_format_s16:
+                    return process_stems(reinterpret_cast<int16_t*>(buffer));
+                default:
+                    return process_stems(buffer);
+            }
+        }
+        if(workers.empty() || (_processor.get_length() == 0)) {
+            return process_serial();
+        }
+        switch(_device->playback.format) {
+            case ma_format_s16:
+                process_parallel(psg_s16);
+                break;
+            default:
+                process_parallel(psg_f32);
+                break;
+        }
+    };
+
     auto setup = [&]() -> void
     {
         std::string filename;
 
+        if((jobs > 1) && (_chipset == nullptr)) {
+            for(uint32_t job = 0; job < jobs; ++job) {
+                workers.emplace_back(new PlayerProcessor(_device, _settings));
+            }
+        }
         if(_playlist.get(filename) != false) {
-            _processor.load(filename);
+            load(filename);
         }
     };
 
@@ -470,12 +1927,12 @@ void Player::dump()
 
     auto playing = [&]() -> bool
     {
-        bool result = _processor.playing();
+        bool result = (_chipset ? _chipset->playing() : _processor.playing());
 
         if(result == false) {
             std::string filename;
             if((result = _playlist.next(filename)) != false) {
-                _processor.load(filename);
+                load(filename);
             }
         }
         return result;
@@ -18,11 +18,33 @@
 #define __AYM_Player_h__
 
 #include "aym-audio.h"
+#include "aym-blep.h"
+#include "aym-chipset.h"
 #include "aym-emulator.h"
+#include "aym-filter.h"
+#include "aym-kernels.h"
+#include "aym-mixer.h"
 #include "aym-playlist.h"
+#include "aym-resampler.h"
 #include "aym-settings.h"
 #include "ym-archive.h"
 
+// ---------------------------------------------------------------------------
+// aym::Music
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+struct Music
+{
+    uint32_t ticks;
+    uint32_t clock;
+    uint32_t index;
+    uint32_t count;
+};
+
+}
+
 // ---------------------------------------------------------------------------
 // aym::PlayerProcessor
 // ---------------------------------------------------------------------------
@@ -48,6 +70,30 @@ public: // public interface
 
     void load(const std::string& filename);
 
+    void seek(const uint32_t milliseconds);
+
+    void stems(float* channel0, float* channel1, float* channel2, const uint32_t count);
+
+    void stems(int16_t* channel0, int16_t* channel1, int16_t* channel2, const uint32_t count);
+
+    auto get_length() -> uint64_t;
+
+    auto get_position() -> uint64_t;
+
+    auto get_checkpoints() -> std::vector<uint64_t>;
+
+    void fork(const PlayerProcessor& processor);
+
+    void locate(const uint64_t position);
+
+    void generate(Output* buffer, const uint32_t count);
+
+    void generate(OutputInt32* buffer, const uint32_t count);
+
+    void mix(const Output* buffer, void* output, const uint32_t count);
+
+    void mix(const OutputInt32* buffer, void* output, const uint32_t count);
+
     virtual uint8_t aym_port_a_rd(Emulator& emulator, uint8_t data) override final;
 
     virtual uint8_t aym_port_a_wr(Emulator& emulator, uint8_t data) override final;
@@ -57,33 +103,171 @@ public: // public interface
     virtual uint8_t aym_port_b_wr(Emulator& emulator, uint8_t data) override final;
 
 private: // private types
-    struct Music
+    struct Sound
     {
-        uint32_t ticks;
         uint32_t clock;
-        uint32_t index;
-        uint32_t count;
     };
 
-    struct Sound
+    struct Effect
     {
-        uint32_t ticks;
-        uint32_t clock;
+        static constexpr uint8_t NONE        = 0;
+        static constexpr uint8_t SID         = 1;
+        static constexpr uint8_t DIGIDRUM    = 2;
+        static constexpr uint8_t SYNC_BUZZER = 3;
+
+        uint8_t  type;
+        uint8_t  level;
+        uint8_t  output;
+        uint8_t  sample;
+        uint32_t position;
+        uint64_t period;
+        uint64_t step;
+        uint64_t phase;
+    };
+
+    struct Effects
+    {
+        uint8_t  version;
+        uint8_t  touched;
+        uint32_t throttled;
+        Effect   voices[3];
+    };
+
+    struct Keyframe
+    {
+        Music    music;
+        Effects  effects;
+        Snapshot snapshot;
+    };
+
+    struct Index
+    {
+        uint32_t              interval;
+        std::vector<Keyframe> keyframes;
+    };
+
+    struct Native
+    {
+        std::vector<OutputLevel> levels;
+        std::vector<uint32_t>    offsets;
+        std::vector<Output>      output;
+        std::vector<OutputInt32> output_s16;
     };
 
     struct Audio
     {
-        float    volume        = 1.0f;
-        float    dcb_input[2]  = {};
-        float    dcb_output[2] = {};
+        float    volume            = 1.0f;
+    };
+
+private: // private interface
+    auto get_position(const Music& music) const -> uint64_t;
+
+    void rewind_music();
+
+    void process_music();
+
+    void process_effects();
+
+    auto skip_music(const uint32_t remaining) -> uint32_t;
+
+    auto get_latency() const -> uint32_t;
+
+    void render_sound(Output* buffer, const uint32_t count);
+
+    void render_sound(OutputInt32* buffer, const uint32_t count);
+
+    template <typename T>
+    void synthesize(BasicOutput<T>* buffer, std::vector<BasicOutput<T>>& native, const uint32_t count);
+
+    void mix_sound(const Output* buffer, void* output, const uint32_t position, const uint32_t count);
+
+    void mix_sound(const OutputInt32* buffer, void* output, const uint32_t position, const uint32_t count);
+
+    void replay(const uint32_t target, const bool indexing);
+
+private: // private data
+    const uint32_t  _interval;
+    const Synthesis _synthesis;
+    const Kernels&  _kernels;
+    Mixer           _mixer;
+    Filter          _filter;
+    ym::Archive     _archive;
+    Emulator        _emulator;
+    Resampler       _resampler;
+    BlepSynthesizer _blep;
+    Music           _music;
+    Sound           _sound;
+    Effects         _effects;
+    Native          _native;
+    Audio           _audio;
+    Index           _index;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::ChipSetProcessor
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+class ChipSetProcessor final
+    : public AudioProcessor
+    , public Interface
+{
+public: // public interface
+    ChipSetProcessor(AudioDevice& device, const Settings& settings);
+
+    ChipSetProcessor(const ChipSetProcessor&) = delete;
+
+    ChipSetProcessor& operator=(const ChipSetProcessor&) = delete;
+
+    virtual ~ChipSetProcessor() = default;
+
+    virtual void process(const void* input, void* output, const uint32_t count) override final;
+
+    bool playing();
+
+    void load(const std::vector<std::string>& filenames);
+
+    auto get_count() const -> size_t
+    {
+        return _chipset.get_count();
+    }
+
+    virtual uint8_t aym_port_a_rd(Emulator& emulator, uint8_t data) override final;
+
+    virtual uint8_t aym_port_a_wr(Emulator& emulator, uint8_t data) override final;
+
+    virtual uint8_t aym_port_b_rd(Emulator& emulator, uint8_t data) override final;
+
+    virtual uint8_t aym_port_b_wr(Emulator& emulator, uint8_t data) override final;
+
+private: // private types
+    struct Track
+    {
+        ym::Archive archive;
+        Music       music;
     };
 
+private: // private interface
+    void process_music();
+
+    auto skip_music(const uint32_t remaining) -> uint32_t;
+
+    template <typename T>
+    void render_sound(T* const* lanes, const uint32_t count);
+
+    void mix_sound(float* const* lanes, void* output, const uint32_t position, const uint32_t count);
+
+    void mix_sound(int32_t* const* lanes, void* output, const uint32_t position, const uint32_t count);
+
 private: // private data
-    ym::Archive _archive;
-    Emulator    _emulator;
-    Music       _music;
-    Sound       _sound;
-    Audio       _audio;
+    const Kernels&     _kernels;
+    Filter             _filter;
+    ChipSet            _chipset;
+    uint32_t           _clock;
+    std::vector<Track> _tracks;
 };
 
 }
@@ -110,10 +294,11 @@ public: // public interface
     void dump();
 
 private: // private data
-    Settings&       _settings;
-    Playlist&       _playlist;
-    AudioDevice     _device;
-    PlayerProcessor _processor;
+    Settings&                         _settings;
+    Playlist&                         _playlist;
+    AudioDevice                       _device;
+    PlayerProcessor                   _processor;
+    std::unique_ptr<ChipSetProcessor> _chipset;
 };
 
 }
@@ -0,0 +1,278 @@
+/*
+ * aym-resampler.cc - Copyright (c) 2023-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstdarg>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include "aym-resampler.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::ResamplerTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct ResamplerTraits
+{
+    using Resampler   = aym::Resampler;
+    using Output      = aym::Output;
+    using OutputInt32 = aym::OutputInt32;
+
+    template <typename T>
+    using BasicOutput = aym::BasicOutput<T>;
+
+#if defined(__AVX__)
+    static constexpr uint32_t width       = 8;
+#else
+    static constexpr uint32_t width       = 4;
+#endif
+    static constexpr uint32_t max_taps    = 4096;
+    static constexpr double   passband    = 0.40;
+    static constexpr double   stopband    = 0.55;
+    static constexpr double   attenuation = 80.0;
+
+    typedef float Vector __attribute__((vector_size(width * sizeof(float))));
+
+    static inline auto load(const float* input) -> Vector
+    {
+        Vector vector;
+        static_cast<void>(::memcpy(&vector, input, sizeof(vector)));
+        return vector;
+    }
+
+    static inline auto store(const Vector& vector, float* output) -> void
+    {
+        static_cast<void>(::memcpy(output, &vector, sizeof(vector)));
+    }
+
+    static inline auto store(const float value, float& output) -> void
+    {
+        output = value;
+    }
+
+    static inline auto store(const float value, int32_t& output) -> void
+    {
+        output = static_cast<int32_t>(std::lrint(value));
+    }
+
+    static inline auto bessel_i0(const double value) -> double
+    {
+        const double half = (value * 0.5);
+        double       term = 1.0;
+        double       sum  = 1.0;
+
+        for(int index = 1; index < 64; ++index) {
+            term *= (half / index) * (half / index);
+            sum  += term;
+            if(term < (sum * 1e-12)) {
+                break;
+            }
+        }
+        return sum;
+    }
+
+    static inline auto get_taps(const double transition) -> uint32_t
+    {
+        const double   length = (attenuation - 8.0) / (2.285 * 2.0 * M_PI * transition);
+        const uint32_t taps   = static_cast<uint32_t>(std::ceil(length));
+
+        return std::min(std::max(((taps + (width - 1)) / width) * width, width), max_taps);
+    }
+
+    static inline auto interpolate(const float* row0, const float* row1, const float blend, float* kernel, const uint32_t taps) -> void
+    {
+        for(uint32_t index = 0; index < taps; index += width) {
+            const Vector lhs = load(row0 + index);
+            const Vector rhs = load(row1 + index);
+            store((lhs + ((rhs - lhs) * blend)), (kernel + index));
+        }
+    }
+
+    static inline auto dot(const float* input, const float* kernel, const uint32_t taps) -> float
+    {
+        Vector accumulator = {};
+        float  result      = 0.0f;
+
+        for(uint32_t index = 0; index < taps; index += width) {
+            accumulator += load(input + index) * load(kernel + index);
+        }
+        for(uint32_t index = 0; index < width; ++index) {
+            result += accumulator[index];
+        }
+        return result;
+    }
+
+    static inline auto build(std::vector<float>& table, const uint32_t clock, const uint32_t rate) -> uint32_t
+    {
+        const double   native     = (static_cast<double>(clock) / 8.0);
+        const double   ratio      = (native > 0.0 ? static_cast<double>(rate) / native : 1.0);
+        const double   cutoff     = std::min((0.5 * (passband + stopband) * ratio), 0.45);
+        const double   transition = std::min(((stopband - passband) * ratio), 0.5);
+        const double   beta       = 0.1102 * (attenuation - 8.7);
+        const double   scale      = 1.0 / bessel_i0(beta);
+        const uint32_t taps       = get_taps(transition);
+        const double   center     = (static_cast<double>(taps) / 2.0);
+
+        auto get_coef = [&](const double position) -> double
+        {
+            const double ratio  = (position / center);
+            const double window = bessel_i0(beta * std::sqrt(std::max((1.0 - (ratio * ratio)), 0.0))) * scale;
+            if(position == 0.0) {
+                return (2.0 * cutoff) * window;
+            }
+            return (std::sin(2.0 * M_PI * cutoff * position) / (M_PI * position)) * window;
+        };
+
+        auto build_row = [&](float* row, const double offset) -> void
+        {
+            double sum = 0.0;
+            for(uint32_t index = 0; index < taps; ++index) {
+                sum += get_coef(offset + static_cast<double>(taps - 1 - index) - center);
+            }
+            for(uint32_t index = 0; index < taps; ++index) {
+                row[index] = static_cast<float>(get_coef(offset + static_cast<double>(taps - 1 - index) - center) / sum);
+            }
+        };
+
+        auto build = [&]() -> uint32_t
+        {
+            table.resize((Resampler::PHASES + 1) * taps);
+            for(uint32_t phase = 0; phase <= Resampler::PHASES; ++phase) {
+                build_row((table.data() + (phase * taps)), (static_cast<double>(phase) / Resampler::PHASES));
+            }
+            return taps;
+        };
+
+        return build();
+    }
+
+    template <typename T>
+    static inline auto process(const uint32_t taps, const uint32_t clock, const uint32_t rate, const std::vector<float>& table, std::vector<float>& kernel, std::vector<float> (&history)[3], const BasicOutput<T>* input, const size_t steps, BasicOutput<T>* output, const size_t samples, const uint32_t phase, const uint32_t remainder) -> void
+    {
+        const uint64_t divisor = (static_cast<uint64_t>(rate) * 8);
+        const uint64_t offset  = (static_cast<uint64_t>((taps * 8) + phase - 8) * rate);
+
+        auto append = [&]() -> void
+        {
+            history[0].resize(taps + steps);
+            history[1].resize(taps + steps);
+            history[2].resize(taps + steps);
+            for(size_t index = 0; index < steps; ++index) {
+                history[0][taps + index] = static_cast<float>(input[index].channel0);
+                history[1][taps + index] = static_cast<float>(input[index].channel1);
+                history[2][taps + index] = static_cast<float>(input[index].channel2);
+            }
+        };
+
+        auto filter = [&]() -> void
+        {
+            for(size_t index = 0; index < samples; ++index) {
+                const uint64_t position = remainder + (static_cast<uint64_t>(index + 1) * clock) + offset;
+                const uint64_t fraction = (position % divisor) * Resampler::PHASES;
+                const size_t   first    = static_cast<size_t>(position / divisor) - (taps - 1);
+                const float*   row      = table.data() + ((fraction / divisor) * taps);
+                const float    blend    = static_cast<float>(static_cast<double>(fraction % divisor) / static_cast<double>(divisor));
+                interpolate(row, (row + taps), blend, kernel.data(), taps);
+                store(dot((history[0].data() + first), kernel.data(), taps), output[index].channel0);
+                store(dot((history[1].data() + first), kernel.data(), taps), output[index].channel1);
+                store(dot((history[2].data() + first), kernel.data(), taps), output[index].channel2);
+            }
+        };
+
+        auto shift = [&]() -> void
+        {
+            history[0].erase(history[0].begin(), (history[0].begin() + steps));
+            history[1].erase(history[1].begin(), (history[1].begin() + steps));
+            history[2].erase(history[2].begin(), (history[2].begin() + steps));
+        };
+
+        auto process = [&]() -> void
+        {
+            append();
+            filter();
+            shift();
+        };
+
+        return process();
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// aym::Resampler
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+Resampler::Resampler()
+    : _clock(0)
+    , _rate(0)
+    , _taps(0)
+    , _table()
+    , _kernel()
+    , _history()
+{
+    configure(_clock, _rate);
+}
+
+auto Resampler::reset() -> void
+{
+    _history[0].assign(_taps, 0.0f);
+    _history[1].assign(_taps, 0.0f);
+    _history[2].assign(_taps, 0.0f);
+}
+
+auto Resampler::configure(uint32_t clock, uint32_t rate) -> void
+{
+    if((_taps != 0) && (_clock == clock) && (_rate == rate)) {
+        return;
+    }
+    _clock = clock;
+    _rate  = rate;
+    _taps  = ResamplerTraits::build(_table, _clock, _rate);
+    _kernel.resize(_taps);
+    reset();
+}
+
+auto Resampler::process(const Output* input, size_t steps, Output* output, size_t samples, uint32_t phase, uint32_t remainder) -> void
+{
+    return ResamplerTraits::process(_taps, _clock, _rate, _table, _kernel, _history, input, steps, output, samples, phase, remainder);
+}
+
+auto Resampler::process(const OutputInt32* input, size_t steps, OutputInt32* output, size_t samples, uint32_t phase, uint32_t remainder) -> void
+{
+    return ResamplerTraits::process(_taps, _clock, _rate, _table, _kernel, _history, input, steps, output, samples, phase, remainder);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,73 @@
+/*
+ * aym-resampler.h - Copyright (c) 2023-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __AYM_Resampler_h__
+#define __AYM_Resampler_h__
+
+#include "aym-emulator.h"
+
+// ---------------------------------------------------------------------------
+// aym::Resampler
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+class Resampler
+{
+public: // public interface
+    static constexpr uint32_t PHASES = 64;
+
+    Resampler();
+
+    Resampler(Resampler&&) = delete;
+
+    Resampler(const Resampler&) = delete;
+
+    Resampler& operator=(Resampler&&) = delete;
+
+    Resampler& operator=(const Resampler&) = delete;
+
+    virtual ~Resampler() = default;
+
+    auto reset() -> void;
+
+    auto configure(uint32_t clock, uint32_t rate) -> void;
+
+    auto process(const Output* input, size_t steps, Output* output, size_t samples, uint32_t phase, uint32_t remainder) -> void;
+
+    auto process(const OutputInt32* input, size_t steps, OutputInt32* output, size_t samples, uint32_t phase, uint32_t remainder) -> void;
+
+    auto get_taps() const -> uint32_t
+    {
+        return _taps;
+    }
+
+protected: // protected data
+    uint32_t           _clock;
+    uint32_t           _rate;
+    uint32_t           _taps;
+    std::vector<float> _table;
+    std::vector<float> _kernel;
+    std::vector<float> _history[3];
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __AYM_Resampler_h__ */
@@ -43,6 +43,17 @@ Settings::Settings()
     : _chip()
     , _channels()
     , _samplerate()
+    , _format()
+    , _stage()
+    , _synthesis()
+    , _panning()
+    , _filter_profile()
+    , _dump_layout()
+    , _keyframe_interval()
+    , _start_offset()
+    , _jobs()
+    , _chips()
+    , _kernels()
 {
 }
 
@@ -53,6 +64,17 @@ auto Settings::get_config() -> AudioConfig
     config->playback.channels = _channels;
     config->sampleRate        = _samplerate;
 
+    switch(_format) {
+        case SampleFormat::FORMAT_S16:
+            config->playback.format = ma_format_s16;
+            break;
+        case SampleFormat::FORMAT_F32:
+            config->playback.format = ma_format_f32;
+            break;
+        default:
+            break;
+    }
+
     return config;
 }
 
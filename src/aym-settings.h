@@ -19,6 +19,24 @@
 
 #include "aym-audio.h"
 #include "aym-emulator.h"
+#include "aym-filter.h"
+#include "aym-mixer.h"
+
+// ---------------------------------------------------------------------------
+// aym::DumpLayout
+// ---------------------------------------------------------------------------
+
+namespace aym {
+
+enum DumpLayout
+{
+    DUMP_LAYOUT_INVALID = -1,
+    DUMP_LAYOUT_DEFAULT =  0,
+    DUMP_LAYOUT_MIXDOWN =  1,
+    DUMP_LAYOUT_STEMS   =  2,
+};
+
+}
 
 // ---------------------------------------------------------------------------
 // aym::Settings
@@ -54,6 +72,61 @@ public: // public interface
         return _samplerate;
     }
 
+    auto get_format() const -> SampleFormat
+    {
+        return _format;
+    }
+
+    auto get_output_stage() const -> OutputStage
+    {
+        return _stage;
+    }
+
+    auto get_synthesis() const -> Synthesis
+    {
+        return _synthesis;
+    }
+
+    auto get_panning() const -> Panning
+    {
+        return _panning;
+    }
+
+    auto get_filter_profile() const -> FilterProfile
+    {
+        return _filter_profile;
+    }
+
+    auto get_dump_layout() const -> DumpLayout
+    {
+        return _dump_layout;
+    }
+
+    auto get_keyframe_interval() const -> uint32_t
+    {
+        return _keyframe_interval;
+    }
+
+    auto get_start_offset() const -> uint32_t
+    {
+        return _start_offset;
+    }
+
+    auto get_jobs() const -> uint32_t
+    {
+        return _jobs;
+    }
+
+    auto get_chips() const -> uint32_t
+    {
+        return _chips;
+    }
+
+    auto get_kernels() const -> const std::string&
+    {
+        return _kernels;
+    }
+
     auto set_chip(const ChipType chip) -> void
     {
         _chip = chip;
@@ -69,10 +142,76 @@ public: // public interface
         _samplerate = samplerate;
     }
 
+    auto set_format(const SampleFormat format) -> void
+    {
+        _format = format;
+    }
+
+    auto set_output_stage(const OutputStage stage) -> void
+    {
+        _stage = stage;
+    }
+
+    auto set_synthesis(const Synthesis synthesis) -> void
+    {
+        _synthesis = synthesis;
+    }
+
+    auto set_panning(const Panning panning) -> void
+    {
+        _panning = panning;
+    }
+
+    auto set_filter_profile(const FilterProfile filter_profile) -> void
+    {
+        _filter_profile = filter_profile;
+    }
+
+    auto set_dump_layout(const DumpLayout dump_layout) -> void
+    {
+        _dump_layout = dump_layout;
+    }
+
+    auto set_keyframe_interval(const uint32_t keyframe_interval) -> void
+    {
+        _keyframe_interval = keyframe_interval;
+    }
+
+    auto set_start_offset(const uint32_t start_offset) -> void
+    {
+        _start_offset = start_offset;
+    }
+
+    auto set_jobs(const uint32_t jobs) -> void
+    {
+        _jobs = jobs;
+    }
+
+    auto set_chips(const uint32_t chips) -> void
+    {
+        _chips = chips;
+    }
+
+    auto set_kernels(const std::string& kernels) -> void
+    {
+        _kernels = kernels;
+    }
+
 private: // private data
-    ChipType _chip;
-    uint32_t _channels;
-    uint32_t _samplerate;
+    ChipType      _chip;
+    uint32_t      _channels;
+    uint32_t      _samplerate;
+    SampleFormat  _format;
+    OutputStage   _stage;
+    Synthesis     _synthesis;
+    Panning       _panning;
+    FilterProfile _filter_profile;
+    DumpLayout    _dump_layout;
+    uint32_t      _keyframe_interval;
+    uint32_t      _start_offset;
+    uint32_t      _jobs;
+    uint32_t      _chips;
+    std::string   _kernels;
 };
 
 }
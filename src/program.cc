@@ -32,6 +32,7 @@
 #include <thread>
 #include <mutex>
 #include <iostream>
+#include <algorithm>
 #include <stdexcept>
 #include "aym-player.h"
 #include "console.h"
@@ -41,10 +42,17 @@
 // some useful declarations
 // ---------------------------------------------------------------------------
 
-using ChipType = aym::ChipType;
-using Settings = aym::Settings;
-using Playlist = aym::Playlist;
-using Player   = aym::Player;
+using ChipType      = aym::ChipType;
+using SampleFormat  = aym::SampleFormat;
+using OutputStage   = aym::OutputStage;
+using Synthesis     = aym::Synthesis;
+using Panning       = aym::Panning;
+using FilterProfile = aym::FilterProfile;
+using DumpLayout    = aym::DumpLayout;
+using ChipSet       = aym::ChipSet;
+using Settings      = aym::Settings;
+using Playlist      = aym::Playlist;
+using Player        = aym::Player;
 
 enum Command
 {
@@ -113,6 +121,116 @@ void Program::main(const ArgList& args)
         }
     };
 
+    auto set_format = [&](const SampleFormat format) -> void
+    {
+        if(settings.get_format() == 0) {
+            settings.set_format(format);
+        }
+        else {
+            throw std::runtime_error("the sample format has already been given");
+        }
+    };
+
+    auto set_output_stage = [&](const OutputStage stage) -> void
+    {
+        if(settings.get_output_stage() == 0) {
+            settings.set_output_stage(stage);
+        }
+        else {
+            throw std::runtime_error("the output stage has already been given");
+        }
+    };
+
+    auto set_synthesis = [&](const Synthesis synthesis) -> void
+    {
+        if(settings.get_synthesis() == 0) {
+            settings.set_synthesis(synthesis);
+        }
+        else {
+            throw std::runtime_error("the synthesis has already been given");
+        }
+    };
+
+    auto set_panning = [&](const Panning panning) -> void
+    {
+        if(settings.get_panning() == 0) {
+            settings.set_panning(panning);
+        }
+        else {
+            throw std::runtime_error("the panning has already been given");
+        }
+    };
+
+    auto set_filter_profile = [&](const FilterProfile filter_profile) -> void
+    {
+        if(settings.get_filter_profile() == 0) {
+            settings.set_filter_profile(filter_profile);
+        }
+        else {
+            throw std::runtime_error("the filter profile has already been given");
+        }
+    };
+
+    auto set_dump_layout = [&](const DumpLayout dump_layout) -> void
+    {
+        if(settings.get_dump_layout() == 0) {
+            settings.set_dump_layout(dump_layout);
+        }
+        else {
+            throw std::runtime_error("the dump layout has already been given");
+        }
+    };
+
+    auto set_start_offset = [&](const uint32_t start_offset) -> void
+    {
+        if(settings.get_start_offset() == 0) {
+            settings.set_start_offset(start_offset);
+        }
+        else {
+            throw std::runtime_error("the start offset has already been given");
+        }
+    };
+
+    auto set_keyframe_interval = [&](const uint32_t keyframe_interval) -> void
+    {
+        if(settings.get_keyframe_interval() == 0) {
+            settings.set_keyframe_interval(keyframe_interval);
+        }
+        else {
+            throw std::runtime_error("the keyframe interval has already been given");
+        }
+    };
+
+    auto set_jobs = [&](const uint32_t jobs) -> void
+    {
+        if(settings.get_jobs() == 0) {
+            settings.set_jobs(std::max(jobs, 1U));
+        }
+        else {
+            throw std::runtime_error("the render mode has already been given");
+        }
+    };
+
+    auto set_chips = [&](const uint32_t chips) -> void
+    {
+        if(settings.get_chips() == 0) {
+            settings.set_chips(chips);
+        }
+        else {
+            throw std::runtime_error("the number of chips has already been given");
+        }
+    };
+
+    auto set_kernels = [&](const std::string& kernels) -> void
+    {
+        if(settings.get_kernels().empty()) {
+            settings.set_kernels(kernels);
+        }
+        else {
+            throw std::runtime_error("the kernels have already been given");
+        }
+    };
+
     auto add_to_playlist = [&](const std::string& filename) -> void
     {
         playlist.add(filename);
@@ -125,6 +243,19 @@ void Program::main(const ArgList& args)
         throw std::runtime_error(what + ' ' + '<' + argument + '>');
     };
 
+    auto get_number = [&](const std::string& arg, const std::string& prefix, uint32_t& value) -> bool
+    {
+        if(arg.compare(0, prefix.size(), prefix) != 0) {
+            return false;
+        }
+        const std::string digits(arg.substr(prefix.size()));
+        if(digits.empty() || (digits.size() > 9) || (digits.find_first_not_of("0123456789") != std::string::npos)) {
+            invalid_argument(arg);
+        }
+        value = static_cast<uint32_t>(std::stoul(digits));
+        return true;
+    };
+
     auto arg_command = [&](const int argi, const std::string& arg) -> bool
     {
         if(argi == 1) {
@@ -221,6 +352,193 @@ void Program::main(const ArgList& args)
         return false;
     };
 
+    auto arg_format = [&](const int argi, const std::string& arg) -> bool
+    {
+        if(argi >= 2) {
+            if(arg == "s16") {
+                set_format(SampleFormat::FORMAT_S16);
+                return true;
+            }
+            if(arg == "f32") {
+                set_format(SampleFormat::FORMAT_F32);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto arg_output_stage = [&](const int argi, const std::string& arg) -> bool
+    {
+        if(argi >= 2) {
+            if(arg == "linear") {
+                set_output_stage(OutputStage::OUTPUT_STAGE_LINEAR);
+                return true;
+            }
+            if(arg == "mixed") {
+                set_output_stage(OutputStage::OUTPUT_STAGE_MIXED);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto arg_synthesis = [&](const int argi, const std::string& arg) -> bool
+    {
+        if(argi >= 2) {
+            if(arg == "hold") {
+                set_synthesis(Synthesis::SYNTHESIS_HOLD);
+                return true;
+            }
+            if(arg == "fir") {
+                set_synthesis(Synthesis::SYNTHESIS_FIR);
+                return true;
+            }
+            if(arg == "blep") {
+                set_synthesis(Synthesis::SYNTHESIS_BLEP);
+                return true;
+            }
+            if(arg == "area") {
+                set_synthesis(Synthesis::SYNTHESIS_AREA);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto arg_panning = [&](const int argi, const std::string& arg) -> bool
+    {
+        if(argi >= 2) {
+            if(arg == "abc") {
+                set_panning(Panning::PANNING_ABC);
+                return true;
+            }
+            if(arg == "acb") {
+                set_panning(Panning::PANNING_ACB);
+                return true;
+            }
+            if(arg == "bac") {
+                set_panning(Panning::PANNING_BAC);
+                return true;
+            }
+            if(arg == "center") {
+                set_panning(Panning::PANNING_MONO);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto arg_filter_profile = [&](const int argi, const std::string& arg) -> bool
+    {
+        if(argi >= 2) {
+            if(arg == "flat") {
+                set_filter_profile(FilterProfile::FILTER_PROFILE_FLAT);
+                return true;
+            }
+            if(arg == "spectrum") {
+                set_filter_profile(FilterProfile::FILTER_PROFILE_SPECTRUM);
+                return true;
+            }
+            if(arg == "cpc") {
+                set_filter_profile(FilterProfile::FILTER_PROFILE_CPC);
+                return true;
+            }
+            if(arg == "atari") {
+                set_filter_profile(FilterProfile::FILTER_PROFILE_ATARI);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto arg_render_mode = [&](const int argi, const std::string& arg) -> bool
+    {
+        if(argi >= 2) {
+            if(arg == "serial") {
+                set_jobs(1);
+                return true;
+            }
+            if(arg == "parallel") {
+                set_jobs(std::thread::hardware_concurrency());
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto arg_dump_layout = [&](const int argi, const std::string& arg) -> bool
+    {
+        if(argi >= 2) {
+            if(arg == "mixdown") {
+                set_dump_layout(DumpLayout::DUMP_LAYOUT_MIXDOWN);
+                return true;
+            }
+            if(arg == "stems") {
+                set_dump_layout(DumpLayout::DUMP_LAYOUT_STEMS);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto arg_start_offset = [&](const int argi, const std::string& arg) -> bool
+    {
+        uint32_t seconds = 0;
+        if(argi >= 2) {
+            if(get_number(arg, "start=", seconds)) {
+                set_start_offset(seconds * 1000);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto arg_keyframe_interval = [&](const int argi, const std::string& arg) -> bool
+    {
+        uint32_t milliseconds = 0;
+        if(argi >= 2) {
+            if(get_number(arg, "keyframes=", milliseconds)) {
+                set_keyframe_interval(std::max(milliseconds, 1U));
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto arg_chips = [&](const int argi, const std::string& arg) -> bool
+    {
+        uint32_t chips = 0;
+        if(argi >= 2) {
+            if(get_number(arg, "chips=", chips)) {
+                if((chips == 0) || (chips > ChipSet::MAX_CHIPS)) {
+                    invalid_argument(arg);
+                }
+                set_chips(chips);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto arg_kernels = [&](const int argi, const std::string& arg) -> bool
+    {
+        if(argi >= 2) {
+            if(arg == "kernels=default") {
+                set_kernels("default");
+                return true;
+            }
+            if(arg == "kernels=avx2") {
+                set_kernels("avx2");
+                return true;
+            }
+            if(arg == "kernels=avx512") {
+                set_kernels("avx512");
+                return true;
+            }
+        }
+        return false;
+    };
+
     auto arg_filename = [&](const int argi, const std::string& arg) -> bool
     {
         if(argi >= 2) {
@@ -251,6 +569,39 @@ void Program::main(const ArgList& args)
             else if(arg_samplerate(argi, arg)) {
                 /* do nothing */;
             }
+            else if(arg_format(argi, arg)) {
+                /* do nothing */;
+            }
+            else if(arg_output_stage(argi, arg)) {
+                /* do nothing */;
+            }
+            else if(arg_synthesis(argi, arg)) {
+                /* do nothing */;
+            }
+            else if(arg_panning(argi, arg)) {
+                /* do nothing */;
+            }
+            else if(arg_filter_profile(argi, arg)) {
+                /* do nothing */;
+            }
+            else if(arg_render_mode(argi, arg)) {
+                /* do nothing */;
+            }
+            else if(arg_dump_layout(argi, arg)) {
+                /* do nothing */;
+            }
+            else if(arg_start_offset(argi, arg)) {
+                /* do nothing */;
+            }
+            else if(arg_keyframe_interval(argi, arg)) {
+                /* do nothing */;
+            }
+            else if(arg_chips(argi, arg)) {
+                /* do nothing */;
+            }
+            else if(arg_kernels(argi, arg)) {
+                /* do nothing */;
+            }
             else if(arg_filename(argi, arg)) {
                 /* do nothing */;
             }
@@ -351,6 +702,65 @@ void Program::help(const ArgList& args)
         std::cout << "    48000               DVD quality"                        << std::endl;
         std::cout << "    96000               BRD quality"                        << std::endl;
         std::cout << ""                                                           << std::endl;
+        std::cout << "Sample-Format:"                                             << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "    s16                 16-bit integer"                     << std::endl;
+        std::cout << "    f32                 32-bit float"                       << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "Output-Stage:"                                              << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "    linear              independent channels"               << std::endl;
+        std::cout << "    mixed               non-linear mixed channels"          << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "Synthesis:"                                                 << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "    hold                sample-and-hold"                    << std::endl;
+        std::cout << "    fir                 band-limited polyphase resampler"   << std::endl;
+        std::cout << "    blep                band-limited step synthesis"        << std::endl;
+        std::cout << "    area                area-averaged sample-and-hold"      << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "Panning:"                                                   << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "    abc                 A left, B center, C right"          << std::endl;
+        std::cout << "    acb                 A left, C center, B right"          << std::endl;
+        std::cout << "    bac                 B left, A center, C right"          << std::endl;
+        std::cout << "    center              all channels centered"              << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "Filter-Profile:"                                            << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "    flat                DC blocker only"                    << std::endl;
+        std::cout << "    spectrum            ZX Spectrum, 20Hz-8kHz"             << std::endl;
+        std::cout << "    cpc                 Amstrad CPC, 16Hz-10kHz"            << std::endl;
+        std::cout << "    atari               Atari ST, 25Hz-6.5kHz"              << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "Render-Mode:"                                               << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "    serial              dump on a single core"              << std::endl;
+        std::cout << "    parallel            dump on all available cores"        << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "Dump-Layout:"                                               << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "    mixdown             interleaved mixed frames"           << std::endl;
+        std::cout << "    stems               planar blocks of channels A, B, C"  << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "Start-Offset:"                                              << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "    start=SECONDS       start each file at SECONDS"         << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "Keyframes:"                                                 << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "    keyframes=MS        seek index interval (2000)"         << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "Chips:"                                                     << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "    chips=N             play N files at once, one per chip" << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "Kernels:"                                                   << std::endl;
+        std::cout << ""                                                           << std::endl;
+        std::cout << "    kernels=default     portable kernels"                   << std::endl;
+        std::cout << "    kernels=avx2        AVX2 kernels"                       << std::endl;
+        std::cout << "    kernels=avx512      AVX-512 kernels"                    << std::endl;
+        std::cout << ""                                                           << std::endl;
     };
 
     return usage();